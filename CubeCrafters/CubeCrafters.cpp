@@ -14,10 +14,14 @@ int main()
 	ShaderManager::RegisterShader(ShaderObject::Register("shaders/default", "default"));
 	ShaderManager::RegisterShader(ShaderObject::Register("shaders/wireframe", "wireframe"));
 	TextureManager::RegisterTexture(Texture::Register("textures/block.png", "block"));
-	TextureManager::RegisterTexture(Texture::Register("textures/terrain.png", "atlas"));
+	TextureManager::RegisterTexture(BlockManager::RegisterAtlas("textures/terrain.png", "atlas"));
 
 	Window::GenerateWindow("CubeCrafters* 0.1.8", { 750, 450 });
 
+	ShaderManager::GenerateShaders();
+	TextureManager::GenerateTextures();
+	Chunk::RegisterAtlasUniforms();
+
 	Input::Initialize(Window::window);
 
 	player.Initialize({ 0, 20, 0 });
@@ -33,9 +37,10 @@ int main()
 		Input::UpdateInput();
 
 		player.Update();
+		World::FlushEdits();
 		
 		MainThreadExecutor::UpdateTasks();
-		World::playerPosition = player.transform.position;
+		World::UpdatePlayer(player.transform.position, player.camera.projection * player.camera.view);
 
 		Renderer::RenderObjects(player.camera);
 
@@ -46,8 +51,10 @@ int main()
 
 	ShaderManager::CleanUp();
 	Renderer::CleanUp();
+	QuadIndexBuffer::CleanUp();
 	Window::CleanUp();
 	Logger_CleanUp();
+	JobSystem::Terminate();
 
 	return 0;
 }
\ No newline at end of file
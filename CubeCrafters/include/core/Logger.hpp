@@ -13,10 +13,10 @@
 #include <format>
 #include <filesystem>
 #include "thread/MainThreadExecutor.hpp"
-#include "thread/ThreadTaskExecutor.hpp"
+#include "thread/JobSystem.hpp"
 #include "util/ANSIFormatter.hpp"
 
-#define Logger_Init() loggerExecutor.AddTask(__LoggerInit)
+#define Logger_Init() (JobSystem::errorReporter = __LoggerReportJobError, loggerExecutor.AddTask(__LoggerInit))
 
 #define Logger_WriteConsole(message, level) loggerExecutor.AddTask(std::bind(__LoggerWriteConsole, message, std::string(__FUNCTION__), level))
 #define Logger_ThrowError(unexpectedd, message, fatal) loggerExecutor.AddTask(std::bind(__LoggerThrowError, unexpectedd, message, std::string(__FUNCTION__), __LINE__, fatal))
@@ -43,7 +43,7 @@ std::ofstream loggerSaveFile;
 std::thread::id loggerThreadID;
 time_t loggerTimeNow;
 struct tm loggerLocalTime;
-ThreadTaskExecutor loggerExecutor;
+SerialJobQueue loggerExecutor(JobPriority::LOW);
 
 bool loggerClosing = false;
 
@@ -166,6 +166,11 @@ void __LoggerThrowError(const std::string& unexpected, const std::string& messag
 	}
 }
 
+void __LoggerReportJobError(const std::string& message)
+{
+	Logger_ThrowError("job", message, false);
+}
+
 void __LoggerCleanUp()
 {
 	loggerSaveFile.close();
@@ -6,6 +6,9 @@
 namespace Settings
 {
 	const std::string defaultDomain = "cubecrafters";
+	const std::string shaderCacheDirectory = "cache/shaders";
+	const std::string textureCacheDirectory = "cache/textures";
+	const bool runBenchmarks = false;
 }
 
 #endif // !SETTINGS_HPP
\ No newline at end of file
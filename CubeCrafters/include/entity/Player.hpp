@@ -56,6 +56,9 @@ private:
 
 		Renderer::RegisterObject(wireframeBox);
 
+		if (Input::GetKeyJustPressed(GLFW_KEY_G))
+			World::SetMeshingMode(Chunk::meshingMode == MeshingMode::GREEDY ? MeshingMode::NAIVE : MeshingMode::GREEDY);
+
 		if (Input::GetMouseButton(0, GLFW_PRESS))
 		{
 			glm::ivec3 blockPosition = Raycast::Shoot(camera.transform.position, camera.transform.rotation, 5.0f);
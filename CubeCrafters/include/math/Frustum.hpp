@@ -0,0 +1,41 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <array>
+#include <glm/glm.hpp>
+
+struct Frustum
+{
+    std::array<glm::vec4, 6> planes = {};
+
+    bool IntersectsBox(const glm::vec3& min, const glm::vec3& max) const
+    {
+        for (const glm::vec4& plane : planes)
+        {
+            glm::vec3 positive = { plane.x >= 0 ? max.x : min.x, plane.y >= 0 ? max.y : min.y, plane.z >= 0 ? max.z : min.z };
+
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    static Frustum Register(const glm::mat4& viewProjection)
+    {
+        Frustum out = {};
+
+        glm::mat4 matrix = glm::transpose(viewProjection);
+
+        out.planes[0] = matrix[3] + matrix[0];
+        out.planes[1] = matrix[3] - matrix[0];
+        out.planes[2] = matrix[3] + matrix[1];
+        out.planes[3] = matrix[3] - matrix[1];
+        out.planes[4] = matrix[3] + matrix[2];
+        out.planes[5] = matrix[3] - matrix[2];
+
+        return out;
+    }
+};
+
+#endif // !FRUSTUM_HPP
\ No newline at end of file
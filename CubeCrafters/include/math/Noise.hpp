@@ -0,0 +1,346 @@
+#ifndef NOISE_HPP
+#define NOISE_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NOISE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NOISE_SSE2
+#endif
+
+struct NoiseSettings
+{
+    float frequency = 0.01f;
+    int octaves = 4;
+    float lacunarity = 2.0f;
+    float persistence = 0.5f;
+};
+
+namespace Noise
+{
+    constexpr int GridSize = 16;
+
+    using Grid = std::array<float, GridSize * GridSize>;
+
+    inline uint32_t Hash(int x, int y, uint32_t seed)
+    {
+        uint32_t hash = seed;
+
+        hash ^= (uint32_t)x * 0x27d4eb2du;
+        hash ^= (uint32_t)y * 0x165667b1u;
+        hash *= 0x2c1b3c6du;
+        hash ^= hash >> 15;
+
+        return hash;
+    }
+
+    inline uint32_t Hash(int x, int y, int z, uint32_t seed)
+    {
+        uint32_t hash = seed;
+
+        hash ^= (uint32_t)x * 0x27d4eb2du;
+        hash ^= (uint32_t)y * 0x165667b1u;
+        hash ^= (uint32_t)z * 0x1b873593u;
+        hash *= 0x2c1b3c6du;
+        hash ^= hash >> 15;
+
+        return hash;
+    }
+
+    inline float Gradient(uint32_t hash, float x, float y)
+    {
+        return ((hash & 1) ? -x : x) + ((hash & 2) ? -y : y);
+    }
+
+    inline float Gradient(uint32_t hash, float x, float y, float z)
+    {
+        return ((hash & 1) ? -x : x) + ((hash & 2) ? -y : y) + ((hash & 4) ? -z : z);
+    }
+
+    inline float Fade(float t)
+    {
+        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    inline float Lerp(float a, float b, float t)
+    {
+        return a + t * (b - a);
+    }
+
+    inline float Sample(float x, float y, uint32_t seed)
+    {
+        float floorX = std::floor(x);
+        float floorY = std::floor(y);
+
+        int x0 = (int)floorX;
+        int y0 = (int)floorY;
+
+        float fx = x - floorX;
+        float fy = y - floorY;
+
+        float g00 = Gradient(Hash(x0, y0, seed), fx, fy);
+        float g10 = Gradient(Hash(x0 + 1, y0, seed), fx - 1.0f, fy);
+        float g01 = Gradient(Hash(x0, y0 + 1, seed), fx, fy - 1.0f);
+        float g11 = Gradient(Hash(x0 + 1, y0 + 1, seed), fx - 1.0f, fy - 1.0f);
+
+        float u = Fade(fx);
+        float v = Fade(fy);
+
+        return Lerp(Lerp(g00, g10, u), Lerp(g01, g11, u), v);
+    }
+
+    inline float Sample(float x, float y, float z, uint32_t seed)
+    {
+        float floorX = std::floor(x);
+        float floorY = std::floor(y);
+        float floorZ = std::floor(z);
+
+        int x0 = (int)floorX;
+        int y0 = (int)floorY;
+        int z0 = (int)floorZ;
+
+        float fx = x - floorX;
+        float fy = y - floorY;
+        float fz = z - floorZ;
+
+        float g000 = Gradient(Hash(x0, y0, z0, seed), fx, fy, fz);
+        float g100 = Gradient(Hash(x0 + 1, y0, z0, seed), fx - 1.0f, fy, fz);
+        float g010 = Gradient(Hash(x0, y0 + 1, z0, seed), fx, fy - 1.0f, fz);
+        float g110 = Gradient(Hash(x0 + 1, y0 + 1, z0, seed), fx - 1.0f, fy - 1.0f, fz);
+        float g001 = Gradient(Hash(x0, y0, z0 + 1, seed), fx, fy, fz - 1.0f);
+        float g101 = Gradient(Hash(x0 + 1, y0, z0 + 1, seed), fx - 1.0f, fy, fz - 1.0f);
+        float g011 = Gradient(Hash(x0, y0 + 1, z0 + 1, seed), fx, fy - 1.0f, fz - 1.0f);
+        float g111 = Gradient(Hash(x0 + 1, y0 + 1, z0 + 1, seed), fx - 1.0f, fy - 1.0f, fz - 1.0f);
+
+        float u = Fade(fx);
+        float v = Fade(fy);
+        float w = Fade(fz);
+
+        return Lerp(Lerp(Lerp(g000, g100, u), Lerp(g010, g110, u), v), Lerp(Lerp(g001, g101, u), Lerp(g011, g111, u), v), w);
+    }
+
+    inline uint32_t GetOctaveSeed(uint32_t seed, int octave)
+    {
+        return seed + (uint32_t)octave * 0x9e3779b9u;
+    }
+
+    inline float SampleFractal(float x, float y, uint32_t seed, const NoiseSettings& settings)
+    {
+        float total = 0.0f;
+        float frequency = settings.frequency;
+        float amplitude = 1.0f;
+
+        for (int octave = 0; octave < settings.octaves; ++octave)
+        {
+            total += Sample(x * frequency, y * frequency, GetOctaveSeed(seed, octave)) * amplitude;
+
+            frequency *= settings.lacunarity;
+            amplitude *= settings.persistence;
+        }
+
+        return total;
+    }
+
+    inline float SampleFractal(float x, float y, float z, uint32_t seed, const NoiseSettings& settings)
+    {
+        float total = 0.0f;
+        float frequency = settings.frequency;
+        float amplitude = 1.0f;
+
+        for (int octave = 0; octave < settings.octaves; ++octave)
+        {
+            total += Sample(x * frequency, y * frequency, z * frequency, GetOctaveSeed(seed, octave)) * amplitude;
+
+            frequency *= settings.lacunarity;
+            amplitude *= settings.persistence;
+        }
+
+        return total;
+    }
+
+    inline void SampleGridScalar(const glm::ivec2& origin, uint32_t seed, const NoiseSettings& settings, Grid& out)
+    {
+        for (int z = 0; z < GridSize; ++z)
+        {
+            for (int x = 0; x < GridSize; ++x)
+                out[z * GridSize + x] = SampleFractal((float)(origin.x + x), (float)(origin.y + z), seed, settings);
+        }
+    }
+
+#if defined(NOISE_AVX2)
+
+    constexpr const char* SimdName = "AVX2";
+    constexpr int SimdWidth = 8;
+
+    using FloatVector = __m256;
+    using IntVector = __m256i;
+
+    inline IntVector SetInt(int value) { return _mm256_set1_epi32(value); }
+    inline FloatVector SetFloat(float value) { return _mm256_set1_ps(value); }
+    inline IntVector Add(IntVector a, IntVector b) { return _mm256_add_epi32(a, b); }
+    inline IntVector Xor(IntVector a, IntVector b) { return _mm256_xor_si256(a, b); }
+    inline IntVector And(IntVector a, IntVector b) { return _mm256_and_si256(a, b); }
+    inline IntVector MultiplyLow(IntVector a, IntVector b) { return _mm256_mullo_epi32(a, b); }
+    inline IntVector ShiftRight(IntVector a, int count) { return _mm256_srli_epi32(a, count); }
+    inline IntVector ShiftLeft(IntVector a, int count) { return _mm256_slli_epi32(a, count); }
+    inline FloatVector Add(FloatVector a, FloatVector b) { return _mm256_add_ps(a, b); }
+    inline FloatVector Subtract(FloatVector a, FloatVector b) { return _mm256_sub_ps(a, b); }
+    inline FloatVector Multiply(FloatVector a, FloatVector b) { return _mm256_mul_ps(a, b); }
+    inline FloatVector FlipSign(FloatVector a, IntVector signBits) { return _mm256_xor_ps(a, _mm256_castsi256_ps(signBits)); }
+    inline FloatVector Floor(FloatVector a) { return _mm256_floor_ps(a); }
+    inline IntVector ToInt(FloatVector a) { return _mm256_cvttps_epi32(a); }
+    inline FloatVector ToFloat(IntVector a) { return _mm256_cvtepi32_ps(a); }
+    inline FloatVector Sequence() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+    inline void Store(float* out, FloatVector a) { _mm256_storeu_ps(out, a); }
+
+#elif defined(NOISE_SSE2)
+
+    constexpr const char* SimdName = "SSE2";
+    constexpr int SimdWidth = 4;
+
+    using FloatVector = __m128;
+    using IntVector = __m128i;
+
+    inline IntVector SetInt(int value) { return _mm_set1_epi32(value); }
+    inline FloatVector SetFloat(float value) { return _mm_set1_ps(value); }
+    inline IntVector Add(IntVector a, IntVector b) { return _mm_add_epi32(a, b); }
+    inline IntVector Xor(IntVector a, IntVector b) { return _mm_xor_si128(a, b); }
+    inline IntVector And(IntVector a, IntVector b) { return _mm_and_si128(a, b); }
+    inline IntVector ShiftRight(IntVector a, int count) { return _mm_srli_epi32(a, count); }
+    inline IntVector ShiftLeft(IntVector a, int count) { return _mm_slli_epi32(a, count); }
+    inline FloatVector Add(FloatVector a, FloatVector b) { return _mm_add_ps(a, b); }
+    inline FloatVector Subtract(FloatVector a, FloatVector b) { return _mm_sub_ps(a, b); }
+    inline FloatVector Multiply(FloatVector a, FloatVector b) { return _mm_mul_ps(a, b); }
+    inline FloatVector FlipSign(FloatVector a, IntVector signBits) { return _mm_xor_ps(a, _mm_castsi128_ps(signBits)); }
+    inline IntVector ToInt(FloatVector a) { return _mm_cvttps_epi32(a); }
+    inline FloatVector ToFloat(IntVector a) { return _mm_cvtepi32_ps(a); }
+    inline FloatVector Sequence() { return _mm_setr_ps(0, 1, 2, 3); }
+    inline void Store(float* out, FloatVector a) { _mm_storeu_ps(out, a); }
+
+    inline IntVector MultiplyLow(IntVector a, IntVector b)
+    {
+        IntVector even = _mm_mul_epu32(a, b);
+        IntVector odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    inline FloatVector Floor(FloatVector a)
+    {
+        FloatVector truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+
+        return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.0f)));
+    }
+
+#endif
+
+#if defined(NOISE_AVX2) || defined(NOISE_SSE2)
+
+    inline IntVector Hash(IntVector x, IntVector y, IntVector seed)
+    {
+        IntVector hash = seed;
+
+        hash = Xor(hash, MultiplyLow(x, SetInt((int)0x27d4eb2du)));
+        hash = Xor(hash, MultiplyLow(y, SetInt((int)0x165667b1u)));
+        hash = MultiplyLow(hash, SetInt((int)0x2c1b3c6du));
+
+        return Xor(hash, ShiftRight(hash, 15));
+    }
+
+    inline FloatVector Gradient(IntVector hash, FloatVector x, FloatVector y)
+    {
+        IntVector signX = ShiftLeft(And(hash, SetInt(1)), 31);
+        IntVector signY = ShiftLeft(And(hash, SetInt(2)), 30);
+
+        return Add(FlipSign(x, signX), FlipSign(y, signY));
+    }
+
+    inline FloatVector Fade(FloatVector t)
+    {
+        FloatVector inner = Add(Multiply(t, Subtract(Multiply(t, SetFloat(6.0f)), SetFloat(15.0f))), SetFloat(10.0f));
+
+        return Multiply(Multiply(Multiply(t, t), t), inner);
+    }
+
+    inline FloatVector Lerp(FloatVector a, FloatVector b, FloatVector t)
+    {
+        return Add(a, Multiply(t, Subtract(b, a)));
+    }
+
+    inline FloatVector Sample(FloatVector x, FloatVector y, IntVector seed)
+    {
+        FloatVector floorX = Floor(x);
+        FloatVector floorY = Floor(y);
+
+        IntVector x0 = ToInt(floorX);
+        IntVector y0 = ToInt(floorY);
+        IntVector x1 = Add(x0, SetInt(1));
+        IntVector y1 = Add(y0, SetInt(1));
+
+        FloatVector fx = Subtract(x, floorX);
+        FloatVector fy = Subtract(y, floorY);
+        FloatVector fx1 = Subtract(fx, SetFloat(1.0f));
+        FloatVector fy1 = Subtract(fy, SetFloat(1.0f));
+
+        FloatVector g00 = Gradient(Hash(x0, y0, seed), fx, fy);
+        FloatVector g10 = Gradient(Hash(x1, y0, seed), fx1, fy);
+        FloatVector g01 = Gradient(Hash(x0, y1, seed), fx, fy1);
+        FloatVector g11 = Gradient(Hash(x1, y1, seed), fx1, fy1);
+
+        FloatVector u = Fade(fx);
+        FloatVector v = Fade(fy);
+
+        return Lerp(Lerp(g00, g10, u), Lerp(g01, g11, u), v);
+    }
+
+    inline void SampleGridSimd(const glm::ivec2& origin, uint32_t seed, const NoiseSettings& settings, Grid& out)
+    {
+        for (int z = 0; z < GridSize; ++z)
+        {
+            for (int x = 0; x < GridSize; x += SimdWidth)
+            {
+                FloatVector worldX = Add(SetFloat((float)(origin.x + x)), Sequence());
+                FloatVector worldZ = SetFloat((float)(origin.y + z));
+
+                FloatVector total = SetFloat(0.0f);
+                float frequency = settings.frequency;
+                float amplitude = 1.0f;
+
+                for (int octave = 0; octave < settings.octaves; ++octave)
+                {
+                    FloatVector sample = Sample(Multiply(worldX, SetFloat(frequency)), Multiply(worldZ, SetFloat(frequency)), SetInt((int)GetOctaveSeed(seed, octave)));
+                    total = Add(total, Multiply(sample, SetFloat(amplitude)));
+
+                    frequency *= settings.lacunarity;
+                    amplitude *= settings.persistence;
+                }
+
+                Store(&out[z * GridSize + x], total);
+            }
+        }
+    }
+
+    inline void SampleGrid(const glm::ivec2& origin, uint32_t seed, const NoiseSettings& settings, Grid& out)
+    {
+        SampleGridSimd(origin, seed, settings, out);
+    }
+
+#else
+
+    constexpr const char* SimdName = "Scalar";
+
+    inline void SampleGrid(const glm::ivec2& origin, uint32_t seed, const NoiseSettings& settings, Grid& out)
+    {
+        SampleGridScalar(origin, seed, settings, out);
+    }
+
+#endif
+}
+
+#endif // !NOISE_HPP
\ No newline at end of file
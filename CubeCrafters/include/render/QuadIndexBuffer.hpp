@@ -0,0 +1,61 @@
+#ifndef QUAD_INDEX_BUFFER_HPP
+#define QUAD_INDEX_BUFFER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glad/glad.h>
+#include "core/Logger.hpp"
+
+namespace QuadIndexBuffer
+{
+	constexpr unsigned int MaxQuads = 65536 / 4;
+
+	unsigned int buffer = 0;
+
+	void Generate()
+	{
+		Logger_FunctionStart;
+
+		std::vector<uint16_t> indices;
+		indices.reserve(MaxQuads * 6);
+
+		for (unsigned int quad = 0; quad < MaxQuads; ++quad)
+		{
+			uint16_t first = (uint16_t)(quad * 4);
+
+			indices.push_back(first);
+			indices.push_back(first + 1);
+			indices.push_back(first + 2);
+
+			indices.push_back(first);
+			indices.push_back(first + 2);
+			indices.push_back(first + 3);
+		}
+
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+
+		int error = glGetError();
+		if (error != GL_NO_ERROR)
+			Logger_ThrowError(std::to_string(error), std::format("OpenGL error: {}", error), false);
+
+		Logger_FunctionEnd;
+	}
+
+	unsigned int Get()
+	{
+		if (buffer == 0)
+			Generate();
+
+		return buffer;
+	}
+
+	void CleanUp()
+	{
+		glDeleteBuffers(1, &buffer);
+		buffer = 0;
+	}
+}
+
+#endif // !QUAD_INDEX_BUFFER_HPP
\ No newline at end of file
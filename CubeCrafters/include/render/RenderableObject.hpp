@@ -1,12 +1,15 @@
 #ifndef RENDERABLE_OBJECT_HPP
 #define RENDERABLE_OBJECT_HPP
 
+#include <cstdint>
+#include <algorithm>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include "math/Transform.hpp"
 #include "record/NameIDTag.hpp"
 #include "thread/MainThreadExecutor.hpp"
+#include "render/QuadIndexBuffer.hpp"
 #include "render/ShaderManager.hpp"
 #include "render/TextureManager.hpp"
 
@@ -33,6 +36,28 @@ struct Vertex
 	}
 };
 
+struct ChunkVertex
+{
+	uint32_t data;
+
+	static ChunkVertex Register(const glm::ivec3& position, int face, int tile, int light, int occlusion)
+	{
+		ChunkVertex out = {};
+
+		out.data = (uint32_t)position.x | (uint32_t)position.y << 5 | (uint32_t)position.z << 10 | (uint32_t)face << 15 | (uint32_t)tile << 18 | (uint32_t)light << 26 | (uint32_t)occlusion << 30;
+
+		return out;
+	}
+};
+
+static_assert(sizeof(ChunkVertex) == 4, "ChunkVertex must stay packed into a single 32-bit word");
+
+enum class VertexFormat
+{
+	STANDARD,
+	PACKED_CHUNK
+};
+
 class RenderableObject
 {
 
@@ -41,11 +66,15 @@ public:
 	std::shared_ptr<NameIDTag> name;
 
 	std::vector<Vertex> vertices;
+	std::vector<ChunkVertex> packedVertices;
+	unsigned int packedIndexCount = 0;
 	std::vector<unsigned int> indices;
 
+	VertexFormat vertexFormat = VertexFormat::STANDARD;
+
 	std::shared_ptr<ShaderObject> shader;
 
-	std::map<std::string, Texture> textures;
+	std::map<std::string, std::shared_ptr<Texture>> textures;
 
 	Transform transform = TRANSFORM_DEFAULT;
 
@@ -59,6 +88,12 @@ public:
 		{"EBO", 0}
 	};
 
+	std::map<std::string, GLsizeiptr> capacities =
+	{
+		{"VBO", 0},
+		{"EBO", 0}
+	};
+
 	void GenerateSquare()
 	{
 		std::vector<Vertex> vertices;
@@ -128,6 +163,27 @@ public:
 	{
 		this->vertices = vertices;
 		this->indices = indices;
+		vertexFormat = VertexFormat::STANDARD;
+	}
+
+	void RegisterData(std::vector<ChunkVertex>&& vertices)
+	{
+		this->packedVertices = std::move(vertices);
+		this->indices.clear();
+		vertexFormat = VertexFormat::PACKED_CHUNK;
+	}
+
+	unsigned int GetIndexCount() const
+	{
+		if (vertexFormat == VertexFormat::PACKED_CHUNK)
+			return packedIndexCount;
+
+		return (unsigned int)indices.size();
+	}
+
+	GLenum GetIndexType() const
+	{
+		return vertexFormat == VertexFormat::PACKED_CHUNK ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 	}
 
 	void Generate()
@@ -138,31 +194,21 @@ public:
 		{
 			glGenVertexArrays(1, &buffers["VAO"]);
 			glGenBuffers(1, &buffers["VBO"]);
-			glGenBuffers(1, &buffers["EBO"]);
-
-			glBindVertexArray(buffers["VAO"]);
-
-			glBindBuffer(GL_ARRAY_BUFFER, buffers["VBO"]);
-			glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_DYNAMIC_DRAW);
 
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers["EBO"]);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_DYNAMIC_DRAW);
+			if (vertexFormat == VertexFormat::STANDARD)
+				glGenBuffers(1, &buffers["EBO"]);
 
-			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-			glEnableVertexAttribArray(0);
-
-			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
-			glEnableVertexAttribArray(1);
+			glBindVertexArray(buffers["VAO"]);
 
-			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, textureCoordinates));
-			glEnableVertexAttribArray(2);
+			UploadIndices();
+			UploadVertices();
 
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 			glBindVertexArray(0);
 
 			for (auto& [key, value] : textures)
-				value.Generate();
+				value->Generate();
 
 			shader->Use();
 			shader->SetUniform("diffuse", 0);
@@ -186,26 +232,19 @@ public:
 		if (wireframe)
 			return;
 
-		glGenVertexArrays(1, &buffers["VAO"]);
-		glGenBuffers(1, &buffers["VBO"]);
-		glGenBuffers(1, &buffers["EBO"]);
-
-		glBindVertexArray(buffers["VAO"]);
-
-		glBindBuffer(GL_ARRAY_BUFFER, buffers["VBO"]);
-		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_DYNAMIC_DRAW);
+		if (buffers["VAO"] == 0)
+			glGenVertexArrays(1, &buffers["VAO"]);
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers["EBO"]);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_DYNAMIC_DRAW);
+		if (buffers["VBO"] == 0)
+			glGenBuffers(1, &buffers["VBO"]);
 
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-		glEnableVertexAttribArray(0);
+		if (vertexFormat == VertexFormat::STANDARD && buffers["EBO"] == 0)
+			glGenBuffers(1, &buffers["EBO"]);
 
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
-		glEnableVertexAttribArray(1);
+		glBindVertexArray(buffers["VAO"]);
 
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, textureCoordinates));
-		glEnableVertexAttribArray(2);
+		UploadIndices();
+		UploadVertices();
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
@@ -218,18 +257,18 @@ public:
 
 	void CleanUp()
 	{
-		MainThreadExecutor::QueueTask([this]()
+		MainThreadExecutor::QueueTask([vertexArray = buffers["VAO"], vertexBuffer = buffers["VBO"], elementBuffer = buffers["EBO"]]()
 		{
-			glDeleteVertexArrays(1, &buffers["VAO"]);
-			glDeleteBuffers(1, &buffers["VBO"]);
-			glDeleteBuffers(1, &buffers["EBO"]);
-			
-			shader->CleanUp();
+			glDeleteVertexArrays(1, &vertexArray);
+			glDeleteBuffers(1, &vertexBuffer);
+			glDeleteBuffers(1, &elementBuffer);
 		});
 		
 		vertices.clear();
+		packedVertices.clear();
 		indices.clear();
 		buffers.clear();
+		capacities.clear();
 	}
 
 	static std::shared_ptr<RenderableObject> Register(std::shared_ptr<NameIDTag> name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const std::string& shader)
@@ -243,6 +282,63 @@ public:
 
 		return out;
 	}
+
+private:
+
+	void UploadBuffer(GLenum target, const std::string& buffer, GLsizeiptr size, const void* data)
+	{
+		GLsizeiptr& capacity = capacities[buffer];
+
+		if (size > capacity || size * 4 < capacity)
+		{
+			capacity = size > capacity ? std::max(size, capacity * 2) : size * 2;
+			glBufferData(target, capacity, nullptr, GL_DYNAMIC_DRAW);
+		}
+
+		if (size > 0)
+			glBufferSubData(target, 0, size, data);
+	}
+
+	void UploadIndices()
+	{
+		if (vertexFormat == VertexFormat::PACKED_CHUNK)
+		{
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadIndexBuffer::Get());
+			return;
+		}
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers["EBO"]);
+		UploadBuffer(GL_ELEMENT_ARRAY_BUFFER, "EBO", indices.size() * sizeof(unsigned int), indices.data());
+	}
+
+	void UploadVertices()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, buffers["VBO"]);
+
+		if (vertexFormat == VertexFormat::PACKED_CHUNK)
+		{
+			UploadBuffer(GL_ARRAY_BUFFER, "VBO", packedVertices.size() * sizeof(ChunkVertex), packedVertices.data());
+
+			packedIndexCount = (unsigned int)packedVertices.size() / 4 * 6;
+			std::vector<ChunkVertex>().swap(packedVertices);
+
+			glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, data));
+			glEnableVertexAttribArray(3);
+
+			return;
+		}
+
+		UploadBuffer(GL_ARRAY_BUFFER, "VBO", vertices.size() * sizeof(Vertex), vertices.data());
+
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+		glEnableVertexAttribArray(0);
+
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+		glEnableVertexAttribArray(1);
+
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, textureCoordinates));
+		glEnableVertexAttribArray(2);
+	}
 };
 
 #endif // !RENDERABLE_OBJECT_HPP
\ No newline at end of file
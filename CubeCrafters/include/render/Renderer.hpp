@@ -72,7 +72,7 @@ namespace Renderer
 				for (auto& [key, texture] : object->textures)
 				{
 					glActiveTexture(GL_TEXTURE0 + count);
-					glBindTexture(GL_TEXTURE_2D, texture.textureID);
+					glBindTexture(GL_TEXTURE_2D, texture->textureID);
 
 					int error = glGetError();
 					if (error != GL_NO_ERROR)
@@ -94,6 +94,7 @@ namespace Renderer
 			object->shader->SetUniform("model", model);
 			object->shader->SetUniform("view", camera.view);
 			object->shader->SetUniform("projection", camera.projection);
+			object->shader->SetUniform("packedVertices", object->vertexFormat == VertexFormat::PACKED_CHUNK);
 
 			int error = glGetError();
 			if (error != GL_NO_ERROR)
@@ -110,7 +111,7 @@ namespace Renderer
 			if (object->wireframe)
 				glDrawArraysInstanced(GL_LINES, 0, 2, 12);
 			else
-				glDrawElements(GL_TRIANGLES, object->indices.size(), GL_UNSIGNED_INT, 0);
+				glDrawElements(GL_TRIANGLES, object->GetIndexCount(), object->GetIndexType(), 0);
 
 			error = glGetError();
 			if (error != GL_NO_ERROR)
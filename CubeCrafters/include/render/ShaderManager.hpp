@@ -25,11 +25,17 @@ namespace ShaderManager
 		auto it = registeredShaders.find(name);
 
 		if (it != registeredShaders.end()) 
-			return std::make_shared<ShaderObject>(*(it->second));
+			return it->second;
 		else 
 			return nullptr;
 	}
 
+	void GenerateShaders()
+	{
+		for (auto& [key, shader] : registeredShaders)
+			shader->Generate();
+	}
+
 	void CleanUp()
 	{
 		for (auto& [key, shader] : registeredShaders)
@@ -1,11 +1,14 @@
 #ifndef SHADER_OBJECT_HPP
 #define SHADER_OBJECT_HPP
 
+#include <filesystem>
+#include <fstream>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include "core/Logger.hpp"
 #include "core/Settings.hpp"
+#include "record/Hash.hpp"
 
 std::string LoadFile(const std::string& path)
 {
@@ -32,9 +35,23 @@ public:
     std::string vertexPath = "", fragmentPath = "";
     std::string vertexData = "", fragmentData = "";
     unsigned int shaderProgram = 1;
+    bool generated = false;
 
 	void Generate()
 	{
+		if (generated)
+			return;
+
+		generated = true;
+
+		std::string cachePath = GetCachePath();
+
+		if (LoadProgramBinary(cachePath))
+		{
+			Logger_WriteConsole("Loaded shader program '" + name + "' from cache", LogLevel::INFO);
+			return;
+		}
+
 		unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, vertexData);
 		unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentData);
 
@@ -47,6 +64,8 @@ public:
 
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
+
+		SaveProgramBinary(cachePath);
 	}
 
 	void Use()
@@ -116,7 +135,11 @@ public:
 
 	void CleanUp()
 	{
+		if (!generated)
+			return;
+
 		glDeleteProgram(shaderProgram);
+		generated = false;
 	}
 
 	static std::unique_ptr<ShaderObject> Register(const std::string& path, const std::string& name, const std::string& domain = Settings::defaultDomain)
@@ -136,6 +159,90 @@ public:
 
 private:
 
+	static bool SupportsProgramBinary()
+	{
+		if (glProgramBinary == nullptr || glGetProgramBinary == nullptr)
+			return false;
+
+		int formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+		return formats > 0;
+	}
+
+	std::string GetCachePath() const
+	{
+		std::string driver = std::format("{}|{}|{}", (const char*)glGetString(GL_VENDOR), (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+
+		return Settings::shaderCacheDirectory + "/" + name + "_" + Hash::GenerateSHAHash(vertexData + '\0' + fragmentData + '\0' + driver) + ".bin";
+	}
+
+	bool LoadProgramBinary(const std::string& path)
+	{
+		if (!SupportsProgramBinary())
+			return false;
+
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file.is_open())
+			return false;
+
+		GLenum format = 0;
+		file.read(reinterpret_cast<char*>(&format), sizeof(format));
+
+		if (file.gcount() != sizeof(format))
+			return false;
+
+		std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		if (binary.empty())
+			return false;
+
+		shaderProgram = glCreateProgram();
+		glProgramBinary(shaderProgram, format, binary.data(), (GLsizei)binary.size());
+
+		int success = 0;
+		glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+
+		while (glGetError() != GL_NO_ERROR);
+
+		if (success)
+			return true;
+
+		Logger_WriteConsole("Cached shader program '" + name + "' was rejected by the driver, recompiling", LogLevel::WARNING);
+
+		glDeleteProgram(shaderProgram);
+		std::filesystem::remove(path);
+
+		return false;
+	}
+
+	void SaveProgramBinary(const std::string& path) const
+	{
+		if (!SupportsProgramBinary())
+			return;
+
+		int length = 0;
+		glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		if (length <= 0)
+			return;
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+
+		glGetProgramBinary(shaderProgram, length, nullptr, &format, binary.data());
+
+		if (glGetError() != GL_NO_ERROR)
+			return;
+
+		std::filesystem::create_directories(Settings::shaderCacheDirectory);
+
+		std::ofstream file(path, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		file.write(binary.data(), binary.size());
+	}
+
 	unsigned int CompileShader(GLenum type, const std::string& source) const
 	{
 		unsigned int shader = glCreateShader(type);
@@ -164,6 +271,10 @@ private:
 	void LinkProgram(unsigned int vertexShader, unsigned int fragmentShader)
 	{
 		shaderProgram = glCreateProgram();
+
+		if (SupportsProgramBinary())
+			glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 		glAttachShader(shaderProgram, vertexShader);
 		glAttachShader(shaderProgram, fragmentShader);
 		glLinkProgram(shaderProgram);
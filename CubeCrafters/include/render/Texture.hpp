@@ -1,6 +1,8 @@
 #ifndef TEXTURE_HPP
 #define TEXTURE_HPP
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -10,6 +12,8 @@
 #include <STBI/stb_image.h>
 #include "core/Logger.hpp"
 #include "core/Settings.hpp"
+#include "record/Hash.hpp"
+#include "render/TextureCache.hpp"
 
 #define DEFAULT_TEXTURE_PROPERTIES TextureProperties::Register(GL_REPEAT, GL_NEAREST, true, TextureType::DIFFUSE)
 
@@ -79,9 +83,90 @@ struct Texture
     glm::ivec2 size = { 0.0f, 0.0f };
     unsigned int textureID = 0;
     unsigned char* data = NULL;
+    int components = 0;
+    bool generated = false;
+    std::shared_ptr<MappedFile> mapping;
+
+    virtual void Decode(bool flip)
+    {
+        std::string checksum = Hash::GenerateChecksum(path);
+
+        mapping = TextureCache::Load(checksum, flip, size, components);
+
+        if (mapping)
+        {
+            data = const_cast<unsigned char*>(mapping->GetData() + sizeof(TextureCache::Header));
+            return;
+        }
+
+        stbi_set_flip_vertically_on_load_thread(flip);
+
+        data = stbi_load(path.c_str(), &size.x, &size.y, &components, 0);
+
+        if (!data)
+            Logger_ThrowError("null", std::format("Failed to load texture from path: {}", path), false);
+        else
+            TextureCache::Save(checksum, flip, size, components, data);
+    }
+
+    static void LogCacheBenchmark(const std::vector<std::string>& paths, bool flip)
+    {
+        double decodeSeconds = 0.0, cachedSeconds = 0.0;
+        size_t bytes = 0, count = 0;
+        unsigned int checksum = 0;
+
+        for (const std::string& path : paths)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            glm::ivec2 size = { 0, 0 };
+            int components = 0;
+
+            stbi_set_flip_vertically_on_load_thread(flip);
+            unsigned char* pixels = stbi_load(path.c_str(), &size.x, &size.y, &components, 0);
+
+            std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+
+            if (!pixels)
+                continue;
+
+            std::shared_ptr<MappedFile> file = TextureCache::Load(Hash::GenerateChecksum(path), flip, size, components);
+
+            if (file)
+            {
+                for (size_t offset = 0; offset < file->GetSize(); offset += 4096)
+                    checksum += file->GetData()[offset];
+            }
+
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+            stbi_image_free(pixels);
+
+            if (!file)
+                continue;
+
+            decodeSeconds += std::chrono::duration<double>(middle - start).count();
+            cachedSeconds += std::chrono::duration<double>(end - middle).count();
+            bytes += file->GetSize();
+            count++;
+        }
+
+        if (count == 0)
+            return;
+
+        Logger_WriteConsole(std::format("Texture cache ({} textures, {:.1f} MB): PNG decode {:.2f} ms; mapped cache {:.2f} ms ({:.2f}x, checksum {})", count, bytes / (1024.0 * 1024.0), decodeSeconds * 1000.0, cachedSeconds * 1000.0, decodeSeconds / std::max(cachedSeconds, 1e-9), checksum), LogLevel::INFO);
+    }
 
     virtual void Generate(const TextureProperties& properties = DEFAULT_TEXTURE_PROPERTIES)
     {
+        if (generated)
+            return;
+
+        generated = true;
+
+        if (!data)
+            Decode(properties.flip);
+
         glGenTextures(1, &textureID);
         glBindTexture(GL_TEXTURE_2D, textureID);
 
@@ -94,11 +179,6 @@ struct Texture
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        int nrComponents;
-        stbi_set_flip_vertically_on_load(properties.flip);
-
-        data = stbi_load(path.c_str(), &size.x, &size.y, &nrComponents, 0);
-
         int error = glGetError();
         if (error != GL_NO_ERROR)
             Logger_ThrowError(std::to_string(error), std::format("OpenGL error: {}", error), false);
@@ -108,14 +188,14 @@ struct Texture
             GLenum internalFormat = 0;
             GLenum dataFormat = 0;
 
-            if (nrComponents == 1)
+            if (components == 1)
                 internalFormat = dataFormat = GL_RED;
-            else if (nrComponents == 3)
+            else if (components == 3)
             {
                 internalFormat = GL_SRGB;
                 dataFormat = GL_RGB;
             }
-            else if (nrComponents == 4)
+            else if (components == 4)
             {
                 internalFormat = GL_SRGB_ALPHA;
                 dataFormat = GL_RGBA;
@@ -123,10 +203,18 @@ struct Texture
 
             glTexImage2D(GL_TEXTURE_2D, 0, dataFormat, size.x, size.y, 0, dataFormat, GL_UNSIGNED_BYTE, data);
         }
+
+        Release();
+    }
+
+    void Release()
+    {
+        if (mapping)
+            mapping.reset();
         else
-            Logger_ThrowError("null", std::format("Failed to load texture from path: {}", path), false);
+            stbi_image_free(data);
 
-        stbi_image_free(data);
+        data = NULL;
     }
 
     static Texture Register(const std::string& localPath, const std::string& name, const std::string& domain = Settings::defaultDomain)
@@ -0,0 +1,251 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "render/Texture.hpp"
+
+#define MAX_ATLAS_TILES 256
+
+struct TextureAtlas : Texture
+{
+    struct Tile
+    {
+        std::string name;
+        glm::ivec2 sheetPosition;
+    };
+
+    std::string tileDirectory = "";
+    int tileSize = 16;
+    int gutter = 8;
+    std::vector<Tile> tiles;
+    std::map<std::string, int> tileIndices;
+    std::vector<std::vector<unsigned char>> levels;
+
+    int AddTile(const std::string& tileName, const glm::ivec2& sheetPosition)
+    {
+        auto existing = tileIndices.find(tileName);
+
+        if (existing != tileIndices.end())
+            return existing->second;
+
+        if (tiles.size() >= MAX_ATLAS_TILES)
+        {
+            Logger_ThrowError(tileName, std::format("Atlas '{}' is full, {} tiles at most", name, MAX_ATLAS_TILES), false);
+            return 0;
+        }
+
+        tiles.push_back({ tileName, sheetPosition });
+        tileIndices.insert({ tileName, (int)tiles.size() - 1 });
+
+        return (int)tiles.size() - 1;
+    }
+
+    int GetSlotsPerRow() const
+    {
+        return std::max(1, (int)std::ceil(std::sqrt((double)tiles.size())));
+    }
+
+    int GetSlotSize() const
+    {
+        return tileSize + gutter * 2;
+    }
+
+    int GetMipLevels() const
+    {
+        return (int)std::min(std::bit_width((unsigned int)gutter), std::bit_width((unsigned int)tileSize));
+    }
+
+    glm::ivec2 GetAtlasSize() const
+    {
+        int slots = GetSlotsPerRow();
+        int rows = std::max(1, ((int)tiles.size() + slots - 1) / slots);
+
+        return glm::ivec2(slots, rows) * GetSlotSize();
+    }
+
+    void Decode(bool flip) override
+    {
+        glm::ivec2 atlasSize = GetAtlasSize();
+        int slots = GetSlotsPerRow();
+        int slotSize = GetSlotSize();
+
+        std::vector<unsigned char> pixels((size_t)atlasSize.x * atlasSize.y * 4, 0);
+
+        Texture sheet = Texture::RegisterGlobalPath(path, name);
+        sheet.Decode(flip);
+
+        for (int tile = 0; tile < (int)tiles.size(); ++tile)
+        {
+            Texture source = Texture::RegisterGlobalPath(tileDirectory + "/" + tiles[tile].name + ".png", tiles[tile].name);
+
+            if (std::filesystem::exists(source.path))
+                source.Decode(flip);
+
+            glm::ivec2 origin = glm::ivec2(tile % slots, tile / slots) * slotSize + gutter;
+
+            for (int y = 0; y < tileSize; ++y)
+            {
+                for (int x = 0; x < tileSize; ++x)
+                {
+                    glm::ivec2 texel = { x, y };
+                    unsigned char* out = &pixels[((size_t)(origin.y + y) * atlasSize.x + origin.x + x) * 4];
+
+                    if (source.data)
+                        CopyTexel(source, texel * source.size / tileSize, out);
+                    else
+                        CopyTexel(sheet, tiles[tile].sheetPosition * tileSize + texel, out);
+                }
+            }
+
+            source.Release();
+        }
+
+        sheet.Release();
+
+        GenerateMipChain(std::move(pixels), atlasSize);
+
+        size = atlasSize;
+        components = 4;
+        data = levels[0].data();
+
+        Logger_WriteConsole(std::format("Packed atlas '{}': {} tiles, {}x{}, {} mip levels", name, tiles.size(), size.x, size.y, levels.size()), LogLevel::INFO);
+    }
+
+    void Generate(const TextureProperties& properties = DEFAULT_TEXTURE_PROPERTIES) override
+    {
+        if (generated)
+            return;
+
+        generated = true;
+
+        if (levels.empty())
+            Decode(properties.flip);
+
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, properties.precision == GL_NEAREST ? GL_NEAREST_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, properties.precision);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (int)levels.size() - 1);
+
+        for (int level = 0; level < (int)levels.size(); ++level)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, size.x >> level, size.y >> level, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[level].data());
+
+        int error = glGetError();
+        if (error != GL_NO_ERROR)
+            Logger_ThrowError(std::to_string(error), std::format("OpenGL error: {}", error), false);
+
+        levels.clear();
+        levels.shrink_to_fit();
+        data = NULL;
+    }
+
+    static std::shared_ptr<TextureAtlas> Register(const std::string& sheetPath, const std::string& name, const std::string& domain = Settings::defaultDomain)
+    {
+        std::shared_ptr<TextureAtlas> out = std::make_shared<TextureAtlas>();
+
+        out->name = name;
+        out->path = "assets/" + domain + "/" + sheetPath;
+        out->tileDirectory = "assets/" + domain + "/textures/blocks";
+
+        return out;
+    }
+
+private:
+
+    static void CopyTexel(const Texture& image, const glm::ivec2& texel, unsigned char* out)
+    {
+        if (!image.data || texel.x < 0 || texel.y < 0 || texel.x >= image.size.x || texel.y >= image.size.y)
+        {
+            out[0] = 255;
+            out[1] = 0;
+            out[2] = 255;
+            out[3] = 255;
+
+            return;
+        }
+
+        const unsigned char* in = image.data + ((size_t)texel.y * image.size.x + texel.x) * image.components;
+
+        bool color = image.components >= 3;
+        bool alpha = image.components == 2 || image.components == 4;
+
+        out[0] = in[0];
+        out[1] = color ? in[1] : in[0];
+        out[2] = color ? in[2] : in[0];
+        out[3] = alpha ? in[image.components - 1] : 255;
+    }
+
+    void ExtrudeGutters(std::vector<unsigned char>& pixels, int level) const
+    {
+        int slots = GetSlotsPerRow();
+        int width = GetAtlasSize().x >> level;
+        int levelTile = tileSize >> level;
+        int levelGutter = gutter >> level;
+
+        for (int tile = 0; tile < (int)tiles.size(); ++tile)
+        {
+            glm::ivec2 origin = glm::ivec2(tile % slots, tile / slots) * (GetSlotSize() >> level) + levelGutter;
+
+            for (int y = -levelGutter; y < levelTile + levelGutter; ++y)
+            {
+                for (int x = -levelGutter; x < levelTile + levelGutter; ++x)
+                {
+                    glm::ivec2 edge = glm::clamp(glm::ivec2(x, y), 0, levelTile - 1);
+
+                    if (edge == glm::ivec2(x, y))
+                        continue;
+
+                    std::copy_n(&pixels[((size_t)(origin.y + edge.y) * width + origin.x + edge.x) * 4], 4, &pixels[((size_t)(origin.y + y) * width + origin.x + x) * 4]);
+                }
+            }
+        }
+    }
+
+    void GenerateMipChain(std::vector<unsigned char>&& pixels, glm::ivec2 levelSize)
+    {
+        ExtrudeGutters(pixels, 0);
+
+        levels.clear();
+        levels.push_back(std::move(pixels));
+
+        for (int level = 1; level < GetMipLevels(); ++level)
+        {
+            glm::ivec2 reducedSize = levelSize / 2;
+            std::vector<unsigned char> reduced((size_t)reducedSize.x * reducedSize.y * 4);
+
+            const std::vector<unsigned char>& previous = levels.back();
+
+            for (int y = 0; y < reducedSize.y; ++y)
+            {
+                for (int x = 0; x < reducedSize.x; ++x)
+                {
+                    size_t top = ((size_t)y * 2 * levelSize.x + x * 2) * 4;
+                    size_t bottom = top + (size_t)levelSize.x * 4;
+
+                    for (int channel = 0; channel < 4; ++channel)
+                        reduced[((size_t)y * reducedSize.x + x) * 4 + channel] = (unsigned char)((previous[top + channel] + previous[top + 4 + channel] + previous[bottom + channel] + previous[bottom + 4 + channel] + 2) / 4);
+                }
+            }
+
+            ExtrudeGutters(reduced, level);
+
+            levels.push_back(std::move(reduced));
+            levelSize = reducedSize;
+        }
+    }
+};
+
+#endif // !TEXTURE_ATLAS_HPP
\ No newline at end of file
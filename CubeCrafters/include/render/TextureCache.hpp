@@ -0,0 +1,89 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <glm/glm.hpp>
+#include "core/Settings.hpp"
+#include "util/MappedFile.hpp"
+
+namespace TextureCache
+{
+    const uint32_t CACHE_MAGIC = 0x58544343;
+    const uint32_t CACHE_VERSION = 1;
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        int32_t width;
+        int32_t height;
+        int32_t components;
+        uint32_t flip;
+    };
+
+    std::string GetCachePath(const std::string& checksum, bool flip)
+    {
+        return Settings::textureCacheDirectory + "/" + checksum + (flip ? "_flipped" : "") + ".raw";
+    }
+
+    std::shared_ptr<MappedFile> Load(const std::string& checksum, bool flip, glm::ivec2& size, int& components)
+    {
+        std::shared_ptr<MappedFile> file = MappedFile::Open(GetCachePath(checksum, flip));
+
+        if (!file || file->GetSize() < sizeof(Header))
+            return nullptr;
+
+        Header header = {};
+        std::memcpy(&header, file->GetData(), sizeof(Header));
+
+        if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.flip != (uint32_t)flip)
+            return nullptr;
+
+        if (header.width <= 0 || header.height <= 0 || header.components <= 0 || file->GetSize() != sizeof(Header) + (size_t)header.width * header.height * header.components)
+            return nullptr;
+
+        size = { header.width, header.height };
+        components = header.components;
+
+        return file;
+    }
+
+    void Save(const std::string& checksum, bool flip, const glm::ivec2& size, int components, const unsigned char* data)
+    {
+        Header header = { CACHE_MAGIC, CACHE_VERSION, size.x, size.y, components, (uint32_t)flip };
+
+        std::error_code error;
+        std::filesystem::create_directories(Settings::textureCacheDirectory, error);
+
+        std::string path = GetCachePath(checksum, flip);
+        std::string temporary = path + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+        {
+            std::ofstream file(temporary, std::ios::binary);
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            file.write(reinterpret_cast<const char*>(data), (std::streamsize)size.x * size.y * components);
+
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(temporary, error);
+
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+
+        if (error)
+            std::filesystem::remove(temporary, error);
+    }
+}
+
+#endif // !TEXTURE_CACHE_HPP
\ No newline at end of file
@@ -1,31 +1,66 @@
 #ifndef TEXTURE_MANAGER_HPP
 #define TEXTURE_MANAGER_HPP
 
+#include <memory>
+#include <vector>
 #include "core/Logger.hpp"
 #include "render/Texture.hpp"
+#include "thread/JobSystem.hpp"
 
 namespace TextureManager
 {
-    std::map<std::string, Texture> registeredTextures;
+    std::map<std::string, std::shared_ptr<Texture>> registeredTextures;
+    std::map<std::string, JobHandle> pendingDecodes;
 
-    void RegisterTexture(const Texture& texture)
+    void RegisterTexture(std::shared_ptr<Texture> texture)
     {
         Logger_FunctionStart;
 
-        Logger_WriteConsole("Registered Texture: '" + texture.name + "'", LogLevel::INFO);
+        Logger_WriteConsole("Registered Texture: '" + texture->name + "'", LogLevel::INFO);
 
-        registeredTextures.insert({ texture.name, texture });
+        registeredTextures.insert({ texture->name, texture });
+        pendingDecodes.insert({ texture->name, JobSystem::Schedule([texture] { texture->Decode(DEFAULT_TEXTURE_PROPERTIES.flip); }, JobPriority::HIGH) });
 
         Logger_FunctionEnd;
     }
 
-    Texture GetTexture(const std::string& name)
+    void RegisterTexture(const Texture& texture)
+    {
+        RegisterTexture(std::make_shared<Texture>(texture));
+    }
+
+    std::shared_ptr<Texture> GetTexture(const std::string& name)
     {
         if (!registeredTextures.contains(name))
+        {
             Logger_ThrowError("nullptr", std::format("Failed to load texture: '{}'", name), false);
+            registeredTextures[name] = std::make_shared<Texture>();
+        }
+
+        auto pending = pendingDecodes.find(name);
+
+        if (pending != pendingDecodes.end())
+        {
+            pending->second.Wait();
+            pendingDecodes.erase(pending);
+        }
 
         return registeredTextures[name];
     }
+
+    void GenerateTextures()
+    {
+        std::vector<std::string> paths;
+
+        for (auto& [name, texture] : registeredTextures)
+        {
+            GetTexture(name)->Generate();
+            paths.push_back(texture->path);
+        }
+
+        if (Settings::runBenchmarks)
+            JobSystem::Schedule([paths] { Texture::LogCacheBenchmark(paths, DEFAULT_TEXTURE_PROPERTIES.flip); }, JobPriority::LOW);
+    }
 }
 
 #endif // !TEXTURE_MANAGER_HPP
\ No newline at end of file
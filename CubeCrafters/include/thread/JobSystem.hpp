@@ -0,0 +1,319 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <queue>
+#include <array>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <string>
+#include <iostream>
+
+enum class JobPriority
+{
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2
+};
+
+class JobHandle
+{
+
+public:
+
+    JobHandle() = default;
+
+    explicit JobHandle(std::shared_ptr<std::atomic<bool>> finished) : finished(std::move(finished))
+    {
+
+    }
+
+    bool IsFinished() const
+    {
+        return finished == nullptr || finished->load(std::memory_order_acquire);
+    }
+
+    void Wait() const;
+
+private:
+
+    std::shared_ptr<std::atomic<bool>> finished;
+};
+
+namespace JobSystem
+{
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::array<std::deque<std::function<void()>>, 3> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<int> pendingJobs = 0;
+    std::atomic<unsigned int> nextQueue = 0;
+    bool stopping = false;
+
+    std::once_flag initializeFlag;
+    thread_local int workerIndex = -1;
+
+    bool PopJob(int index, std::function<void()>& job)
+    {
+        int count = (int)queues.size();
+
+        for (int priority = 0; priority < 3; ++priority)
+        {
+            if (index >= 0)
+            {
+                WorkerQueue& own = *queues[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+
+                if (!own.jobs[priority].empty())
+                {
+                    job = std::move(own.jobs[priority].back());
+                    own.jobs[priority].pop_back();
+                    pendingJobs--;
+
+                    return true;
+                }
+            }
+
+            for (int offset = 1; offset <= count; ++offset)
+            {
+                int victim = (index + offset + count) % count;
+
+                if (victim == index)
+                    continue;
+
+                WorkerQueue& other = *queues[victim];
+                std::lock_guard<std::mutex> lock(other.mutex);
+
+                if (!other.jobs[priority].empty())
+                {
+                    job = std::move(other.jobs[priority].front());
+                    other.jobs[priority].pop_front();
+                    pendingJobs--;
+
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    std::atomic<void(*)(const std::string&)> errorReporter = nullptr;
+
+    void ReportError(const std::string& message)
+    {
+        void (*reporter)(const std::string&) = errorReporter.load();
+
+        if (reporter != nullptr)
+            reporter(message);
+        else
+            std::cerr << message << std::endl;
+    }
+
+    void RunTask(const std::function<void()>& task)
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& exception)
+        {
+            ReportError(std::string("A job crashed unexpectedly: ") + exception.what());
+        }
+        catch (...)
+        {
+            ReportError("A job crashed unexpectedly!");
+        }
+    }
+
+    void WorkerLoop(int index)
+    {
+        workerIndex = index;
+
+        while (true)
+        {
+            std::function<void()> job;
+
+            if (PopJob(index, job))
+            {
+                job();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCondition.wait(lock, [] { return stopping || pendingJobs > 0; });
+
+            if (stopping && pendingJobs == 0)
+                return;
+        }
+    }
+
+    void Initialize(unsigned int threadCount = 0)
+    {
+        std::call_once(initializeFlag, [threadCount]()
+        {
+            unsigned int count = threadCount;
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+
+            if (count == 0)
+                count = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+            for (unsigned int i = 0; i < count; ++i)
+                queues.push_back(std::make_unique<WorkerQueue>());
+
+            for (unsigned int i = 0; i < count; ++i)
+                workers.emplace_back(WorkerLoop, (int)i);
+        });
+    }
+
+    JobHandle Schedule(std::function<void()> task, JobPriority priority = JobPriority::NORMAL)
+    {
+        Initialize();
+
+        std::shared_ptr<std::atomic<bool>> finished = std::make_shared<std::atomic<bool>>(false);
+
+        std::function<void()> job = [task = std::move(task), finished]()
+        {
+            RunTask(task);
+            finished->store(true, std::memory_order_release);
+            finished->notify_all();
+        };
+
+        int index = workerIndex >= 0 ? workerIndex : (int)(nextQueue++ % queues.size());
+
+        {
+            WorkerQueue& queue = *queues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            queue.jobs[(int)priority].push_back(std::move(job));
+            pendingJobs++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+
+        sleepCondition.notify_one();
+
+        return JobHandle(finished);
+    }
+
+    bool RunPendingJob()
+    {
+        if (queues.empty())
+            return false;
+
+        std::function<void()> job;
+
+        if (!PopJob(workerIndex, job))
+            return false;
+
+        job();
+
+        return true;
+    }
+
+    void Terminate()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+
+        sleepCondition.notify_all();
+
+        for (std::thread& worker : workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+}
+
+inline void JobHandle::Wait() const
+{
+    if (finished == nullptr)
+        return;
+
+    if (JobSystem::workerIndex < 0)
+    {
+        finished->wait(false, std::memory_order_acquire);
+        return;
+    }
+
+    while (!IsFinished())
+    {
+        if (!JobSystem::RunPendingJob())
+            std::this_thread::yield();
+    }
+}
+
+class SerialJobQueue
+{
+
+public:
+
+    explicit SerialJobQueue(JobPriority priority = JobPriority::NORMAL) : priority(priority)
+    {
+
+    }
+
+    void AddTask(std::function<void()> task)
+    {
+        bool schedule = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push(std::move(task));
+
+            schedule = !scheduled;
+            scheduled = true;
+        }
+
+        if (schedule)
+            JobSystem::Schedule([this] { Drain(); }, priority);
+    }
+
+private:
+
+    std::mutex mutex;
+    std::queue<std::function<void()>> tasks;
+    bool scheduled = false;
+    JobPriority priority;
+
+    void Drain()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (tasks.empty())
+                {
+                    scheduled = false;
+                    return;
+                }
+
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            JobSystem::RunTask(task);
+        }
+    }
+};
+
+#endif // !JOB_SYSTEM_HPP
@@ -1,6 +1,7 @@
 #ifndef THREADED_CHUNK_MAP_HPP
 #define THREADED_CHUNK_MAP_HPP
 
+#include <cstdint>
 #include <mutex>
 #include <unordered_map>
 #include <memory>
@@ -15,7 +16,16 @@ namespace std
     {
         size_t operator()(const glm::ivec3& vec) const
         {
-            return std::hash<int>()(vec.x) ^ (std::hash<int>()(vec.y) << 1) ^ (std::hash<int>()(vec.z) << 2);
+            uint64_t hash = (uint64_t)(uint32_t)vec.x * 0x9E3779B97F4A7C15ull;
+
+            hash ^= (uint64_t)(uint32_t)vec.y * 0xC2B2AE3D27D4EB4Full;
+            hash ^= (uint64_t)(uint32_t)vec.z * 0x165667B19E3779F9ull;
+
+            hash ^= hash >> 32;
+            hash *= 0xD6E8FEB86659FD93ull;
+            hash ^= hash >> 32;
+
+            return (size_t)hash;
         }
     };
 }
@@ -66,11 +76,7 @@ public:
     void RemoveChunk(const glm::ivec3& key) 
     {
         std::lock_guard<std::mutex> guard(mapMutex);
-
-        MainThreadExecutor::QueueTask([this, key]()
-        {
-            loadedChunks.erase(key);
-        });
+        loadedChunks.erase(key);
     }
 
     std::shared_ptr<Chunk> GetChunk(const glm::ivec3& key) 
@@ -0,0 +1,115 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#if defined(_WIN64) || defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <memory>
+#include <string>
+
+class MappedFile
+{
+
+public:
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+#if defined(_WIN64) || defined(_WIN32)
+        if (data)
+            UnmapViewOfFile(data);
+
+        if (mapping)
+            CloseHandle(mapping);
+
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+#else
+        if (data)
+            munmap(data, size);
+#endif
+    }
+
+    const unsigned char* GetData() const
+    {
+        return static_cast<const unsigned char*>(data);
+    }
+
+    size_t GetSize() const
+    {
+        return size;
+    }
+
+    static std::shared_ptr<MappedFile> Open(const std::string& path)
+    {
+        std::shared_ptr<MappedFile> out(new MappedFile());
+
+#if defined(_WIN64) || defined(_WIN32)
+        out->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+        if (out->file == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER length = {};
+
+        if (!GetFileSizeEx(out->file, &length) || length.QuadPart == 0)
+            return nullptr;
+
+        out->mapping = CreateFileMappingA(out->file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (!out->mapping)
+            return nullptr;
+
+        out->data = MapViewOfFile(out->mapping, FILE_MAP_READ, 0, 0, 0);
+        out->size = (size_t)length.QuadPart;
+#else
+        int descriptor = open(path.c_str(), O_RDONLY);
+
+        if (descriptor < 0)
+            return nullptr;
+
+        struct stat status = {};
+
+        if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+        {
+            close(descriptor);
+            return nullptr;
+        }
+
+        void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+
+        if (view == MAP_FAILED)
+            return nullptr;
+
+        out->data = view;
+        out->size = (size_t)status.st_size;
+#endif
+
+        if (!out->data)
+            return nullptr;
+
+        return out;
+    }
+
+private:
+
+    MappedFile() = default;
+
+    void* data = nullptr;
+    size_t size = 0;
+
+#if defined(_WIN64) || defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = NULL;
+#endif
+};
+
+#endif // !MAPPED_FILE_HPP
\ No newline at end of file
@@ -2,9 +2,14 @@
 #define BLOCK_MANAGER_HPP
 
 #include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
 #include <glm/glm.hpp>
+#include "render/TextureAtlas.hpp"
 
-#define AtlasSize 256
+#define CHUNK_SIZE 16
 
 enum class BlockType
 {
@@ -12,132 +17,91 @@ enum class BlockType
     BLOCK_TEST = 1,
     BLOCK_GRASS = 2,
     BLOCK_DIRT = 3,
-    BLOCK_STONE = 4
+    BLOCK_STONE = 4,
+    BLOCK_LOG = 5,
+    BLOCK_LEAVES = 6,
+    BLOCK_GLOWSTONE = 7
 };
 
+const int BLOCK_TYPE_COUNT = 8;
+
 namespace BlockManager
 {
-    const int TilePixelSize = 16;
-    const float PADDING_RATIO = 1.0f / (float)AtlasSize;
-
-    std::array<glm::vec2, 4> GetTextureCoordinates(const glm::ivec2& position) 
+    const std::map<std::string, glm::ivec2> SHEET_TILES =
     {
-        float perTextureSize = (float)TilePixelSize / AtlasSize;
-
-        float u0 = position.x * perTextureSize + PADDING_RATIO * perTextureSize;
-        float v0 = position.y * perTextureSize + PADDING_RATIO * perTextureSize;
-        float u1 = (position.x + 1) * perTextureSize - PADDING_RATIO * perTextureSize;
-        float v1 = (position.y + 1) * perTextureSize - PADDING_RATIO * perTextureSize;
-
-        return
-        {
-            glm::vec2(u0, v0),
-            glm::vec2(u1, v0),
-            glm::vec2(u1, v1),
-            glm::vec2(u0, v1)
-        };
-    }
-
-    std::array<glm::vec2, 4> GetTextureCoordinates(const glm::ivec2& position, float rotation) 
+        { "missing", { 9, 2 } },
+        { "grass_top", { 0, 15 } },
+        { "stone", { 1, 15 } },
+        { "dirt", { 2, 15 } },
+        { "grass_side", { 3, 15 } },
+        { "log_side", { 4, 14 } },
+        { "log_top", { 5, 14 } },
+        { "leaves", { 4, 12 } },
+        { "glowstone", { 9, 9 } }
+    };
+
+    std::shared_ptr<TextureAtlas> atlas;
+    std::array<std::array<uint8_t, 6>, BLOCK_TYPE_COUNT> blockTiles = {};
+
+    std::array<std::string, 6> GetBlockTextures(BlockType type)
     {
-        float perTextureSize = (float)TilePixelSize / AtlasSize;
-
-        float u0 = position.x * perTextureSize + PADDING_RATIO * perTextureSize;
-        float v0 = position.y * perTextureSize + PADDING_RATIO * perTextureSize;
-        float u1 = (position.x + 1) * perTextureSize - PADDING_RATIO * perTextureSize;
-        float v1 = (position.y + 1) * perTextureSize - PADDING_RATIO * perTextureSize;
+        switch (type)
+        {
+        case BlockType::BLOCK_GRASS:
+            return { "grass_top", "dirt", "grass_side", "grass_side", "grass_side", "grass_side" };
 
-        float centerX = (u0 + u1) / 2;
-        float centerY = (v0 + v1) / 2;
+        case BlockType::BLOCK_DIRT:
+            return { "dirt", "dirt", "dirt", "dirt", "dirt", "dirt" };
 
-        std::array<glm::vec2, 4> coordinates =
-        {
-            glm::vec2(u0, v0),
-            glm::vec2(u1, v0),
-            glm::vec2(u1, v1),
-            glm::vec2(u0, v1)
-        };
+        case BlockType::BLOCK_STONE:
+            return { "stone", "stone", "stone", "stone", "stone", "stone" };
 
-        float rad = (float)glm::radians(rotation);
+        case BlockType::BLOCK_LOG:
+            return { "log_top", "log_top", "log_side", "log_side", "log_side", "log_side" };
 
-        for (int i = 0; i < coordinates.size(); i++) 
-        {
-            float translatedX = coordinates[i].x - centerX;
-            float translatedY = coordinates[i].y - centerY;
+        case BlockType::BLOCK_LEAVES:
+            return { "leaves", "leaves", "leaves", "leaves", "leaves", "leaves" };
 
-            float rotatedX = translatedX * (float)cos(rad) - translatedY * (float)sin(rad);
-            float rotatedY = translatedX * (float)sin(rad) + translatedY * (float)cos(rad);
+        case BlockType::BLOCK_GLOWSTONE:
+            return { "glowstone", "glowstone", "glowstone", "glowstone", "glowstone", "glowstone" };
 
-            coordinates[i].x = rotatedX + centerX;
-            coordinates[i].y = rotatedY + centerY;
+        default:
+            return { "missing", "missing", "missing", "missing", "missing", "missing" };
         }
-
-        return coordinates;
     }
 
-    std::array<glm::vec2, 6> GetBlockTexture(BlockType type)
+    std::shared_ptr<TextureAtlas> RegisterAtlas(const std::string& sheetPath, const std::string& name)
     {
-        std::array<glm::vec2, 6> coordinates = {};
+        atlas = TextureAtlas::Register(sheetPath, name);
 
-        switch (type)
-        {
-        case BlockType::BLOCK_AIR:
+        for (int type = 0; type < BLOCK_TYPE_COUNT; ++type)
         {
-            coordinates[0] = glm::ivec2(9, 2);
-            coordinates[1] = glm::ivec2(9, 2);
-            coordinates[2] = glm::ivec2(9, 2);
-            coordinates[3] = glm::ivec2(9, 2);
-            coordinates[4] = glm::ivec2(9, 2);
-            coordinates[5] = glm::ivec2(9, 2);
-            break;
-        }
+            std::array<std::string, 6> textures = GetBlockTextures((BlockType)type);
 
-        case BlockType::BLOCK_TEST:
-        {
-            coordinates[0] = glm::ivec2(9, 2);
-            coordinates[1] = glm::ivec2(9, 2);
-            coordinates[2] = glm::ivec2(9, 2);
-            coordinates[3] = glm::ivec2(9, 2);
-            coordinates[4] = glm::ivec2(9, 2);
-            coordinates[5] = glm::ivec2(9, 2);
-            break;
-        }
+            for (int face = 0; face < 6; ++face)
+            {
+                auto tile = SHEET_TILES.find(textures[face]);
+                glm::ivec2 sheetPosition = tile == SHEET_TILES.end() ? SHEET_TILES.at("missing") : tile->second;
 
-        case BlockType::BLOCK_GRASS:
-        {
-            coordinates[0] = glm::ivec2(0, 15);
-            coordinates[1] = glm::ivec2(2, 15);
-            coordinates[2] = glm::ivec2(3, 15);
-            coordinates[3] = glm::ivec2(3, 15);
-            coordinates[4] = glm::ivec2(3, 15);
-            coordinates[5] = glm::ivec2(3, 15);
-            break;
+                blockTiles[type][face] = (uint8_t)atlas->AddTile(textures[face], sheetPosition);
+            }
         }
 
-        case BlockType::BLOCK_DIRT:
-        {
-            coordinates[0] = glm::ivec2(2, 15);
-            coordinates[1] = glm::ivec2(2, 15);
-            coordinates[2] = glm::ivec2(2, 15);
-            coordinates[3] = glm::ivec2(2, 15);
-            coordinates[4] = glm::ivec2(2, 15);
-            coordinates[5] = glm::ivec2(2, 15);
-            break;
-        }
+        return atlas;
+    }
 
-        case BlockType::BLOCK_STONE:
+    int GetBlockTile(BlockType type, int face)
+    {
+        return blockTiles[(int)type][face];
+    }
+
+    uint8_t GetLightEmission(BlockType type)
+    {
+        switch (type)
         {
-            coordinates[0] = glm::ivec2(1, 15);
-            coordinates[1] = glm::ivec2(1, 15);
-            coordinates[2] = glm::ivec2(1, 15);
-            coordinates[3] = glm::ivec2(1, 15);
-            coordinates[4] = glm::ivec2(1, 15);
-            coordinates[5] = glm::ivec2(1, 15);
-            break;
+        case BlockType::BLOCK_GLOWSTONE: return 15;
+        default: return 0;
         }
-        }
-
-        return coordinates;
     }
 }
 
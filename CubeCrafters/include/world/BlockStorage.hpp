@@ -0,0 +1,140 @@
+#ifndef BLOCK_STORAGE_HPP
+#define BLOCK_STORAGE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "world/BlockManager.hpp"
+
+template<int Size>
+class BlockStorage
+{
+
+public:
+
+    static constexpr int Volume = Size * Size * Size;
+
+    BlockStorage(BlockType type = BlockType::BLOCK_AIR)
+    {
+        Fill(type);
+    }
+
+    BlockType Get(int x, int y, int z) const
+    {
+        if (bitsPerBlock == 0)
+            return palette[0];
+
+        int index = GetIndex(x, y, z) * bitsPerBlock;
+
+        return palette[(data[index >> 6] >> (index & 63)) & ((1ull << bitsPerBlock) - 1)];
+    }
+
+    bool Set(int x, int y, int z, BlockType type)
+    {
+        int paletteIndex = GetPaletteIndex(type);
+
+        if (paletteIndex < 0)
+        {
+            if (palette.size() == 256)
+                Compact();
+
+            palette.push_back(type);
+            paletteIndex = (int)palette.size() - 1;
+
+            if (palette.size() > (1ull << bitsPerBlock))
+                Resize(bitsPerBlock == 0 ? 1 : bitsPerBlock * 2);
+        }
+        else if (bitsPerBlock == 0 || Get(x, y, z) == type)
+            return false;
+
+        int index = GetIndex(x, y, z) * bitsPerBlock;
+        uint64_t mask = ((1ull << bitsPerBlock) - 1) << (index & 63);
+
+        data[index >> 6] = (data[index >> 6] & ~mask) | ((uint64_t)paletteIndex << (index & 63));
+
+        return true;
+    }
+
+    void Fill(BlockType type)
+    {
+        palette = { type };
+        data.clear();
+        data.shrink_to_fit();
+        bitsPerBlock = 0;
+    }
+
+    void Compact()
+    {
+        if (bitsPerBlock == 0)
+            return;
+
+        std::vector<BlockType> blocks(Volume);
+
+        for (int x = 0; x < Size; ++x)
+        {
+            for (int z = 0; z < Size; ++z)
+            {
+                for (int y = 0; y < Size; ++y)
+                    blocks[GetIndex(x, y, z)] = Get(x, y, z);
+            }
+        }
+
+        Fill(blocks[0]);
+
+        for (int x = 0; x < Size; ++x)
+        {
+            for (int z = 0; z < Size; ++z)
+            {
+                for (int y = 0; y < Size; ++y)
+                    Set(x, y, z, blocks[GetIndex(x, y, z)]);
+            }
+        }
+    }
+
+    bool IsUniform() const
+    {
+        return bitsPerBlock == 0;
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return sizeof(*this) + palette.capacity() * sizeof(BlockType) + data.capacity() * sizeof(uint64_t);
+    }
+
+private:
+
+    std::vector<BlockType> palette;
+    std::vector<uint64_t> data;
+    int bitsPerBlock = 0;
+
+    static int GetIndex(int x, int y, int z)
+    {
+        return (x * Size + z) * Size + y;
+    }
+
+    int GetPaletteIndex(BlockType type) const
+    {
+        auto iterator = std::find(palette.begin(), palette.end(), type);
+
+        return iterator == palette.end() ? -1 : (int)(iterator - palette.begin());
+    }
+
+    void Resize(int bits)
+    {
+        std::vector<uint64_t> resized((Volume * bits + 63) / 64);
+
+        for (int index = 0; index < Volume && bitsPerBlock > 0; ++index)
+        {
+            int source = index * bitsPerBlock;
+            int target = index * bits;
+
+            uint64_t value = (data[source >> 6] >> (source & 63)) & ((1ull << bitsPerBlock) - 1);
+            resized[target >> 6] |= value << (target & 63);
+        }
+
+        data = std::move(resized);
+        bitsPerBlock = bits;
+    }
+};
+
+#endif // !BLOCK_STORAGE_HPP
\ No newline at end of file
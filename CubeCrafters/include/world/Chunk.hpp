@@ -2,116 +2,246 @@
 #define CHUNK_HPP
 
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <vector>
 #include <array>
 #include <memory>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
 #include "math/TransformI.hpp"
 #include "render/Renderer.hpp"
+#include "thread/ThreadedChunkMap.hpp"
 #include "world/BlockManager.hpp"
+#include "world/BlockStorage.hpp"
+#include "world/TerrainGenerator.hpp"
 
-#define CHUNK_SIZE 16
+enum class MeshingMode
+{
+    NAIVE,
+    GREEDY
+};
+
+enum class ChunkStage
+{
+    NONE,
+    TERRAIN,
+    CARVED,
+    DECORATED,
+    LIT,
+    MESHED,
+    UPLOADED
+};
+
+enum class LightChannel
+{
+    SKY,
+    BLOCK
+};
+
+const std::array<int, 6> FACE_AXES = { 1, 1, 2, 2, 0, 0 };
+const std::array<glm::ivec3, 6> FACE_NORMALS = { glm::ivec3{ 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 } };
+
+const std::array<std::array<glm::ivec3, 4>, 6> FACE_CORNERS =
+{{
+    {{ { 0, 1, 1 }, { 1, 1, 1 }, { 1, 1, 0 }, { 0, 1, 0 } }},
+    {{ { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 } }},
+    {{ { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } }},
+    {{ { 1, 0, 0 }, { 0, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 } }},
+    {{ { 1, 0, 1 }, { 1, 0, 0 }, { 1, 1, 0 }, { 1, 1, 1 } }},
+    {{ { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 } }}
+}};
+
+static_assert(CHUNK_SIZE == 16, "Chunk columns and face masks store one column per uint16_t");
+
+using FaceMasks = std::array<std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE>, 6>;
+using PaddedOccupancy = std::array<uint32_t, (CHUNK_SIZE + 2) * (CHUNK_SIZE + 2)>;
+using LightVolume = std::array<uint8_t, (CHUNK_SIZE + 2) * (CHUNK_SIZE + 2) * (CHUNK_SIZE + 2)>;
+
+struct ChunkMesh
+{
+    uint64_t version = 0;
+    bool visible = false;
+    std::vector<ChunkVertex> vertices;
+};
+
+static_assert(CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE / 2 * 6 <= QuadIndexBuffer::MaxQuads, "The shared quad index buffer must cover the densest possible chunk mesh");
 
 class Chunk
 {
 
 public:
 	
-	void Initialize(const glm::ivec3& position, bool generateNothing = false)
+	void Initialize(const glm::ivec3& position, ThreadedChunkMap& chunkMap)
 	{
 		transform.position = position;
+		this->chunkMap = &chunkMap;
+	}
 
-		for (int x = 0; x < CHUNK_SIZE; ++x)
-		{
-			for (int y = 0; y < CHUNK_SIZE; ++y)
-			{
-				for (int z = 0; z < CHUNK_SIZE; ++z)
-				{
-					if (generateNothing)
-						blocks[x][y][z] = (int)BlockType::BLOCK_AIR;
-                    else
-                    {
-                        if (y < 15)
-                            blocks[x][y][z] = (int)BlockType::BLOCK_DIRT;
+    void GenerateTerrain(const TerrainGenerator& generator)
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
 
-                        if (y < 12)
-                            blocks[x][y][z] = (int)BlockType::BLOCK_STONE;
+        blocks.Fill(BlockType::BLOCK_AIR);
+        generator.GenerateTerrain(transform.position, blocks);
+
+        CalculateColumns();
+    }
+
+    void Carve(const TerrainGenerator& generator)
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        generator.Carve(transform.position, blocks);
+        blocks.Compact();
+
+        CalculateColumns();
+    }
+
+    void Decorate(const TerrainGenerator& generator, const BlockReader& neighborhood)
+    {
+        BlockStorage<CHUNK_SIZE> decorated;
 
-                        blocks[x][15][z] = (int)BlockType::BLOCK_GRASS;
-                    }
-				}
-			}
-		}
-		
-		mesh = RenderableObject::Register(NameIDTag::Register(std::format("Chunk_{}_{}_{}", position.x, position.y, position.z), this), {}, {}, "default");
-		mesh->transform = transform.ToTransform();
-
-        MainThreadExecutor::QueueTask([this]()
         {
-            mesh->RegisterTexture("atlas");
-        });
+            std::lock_guard<std::mutex> guard(chunkMutex);
+            decorated = blocks;
+        }
 
-		Rebuild();
-	}
+        generator.Decorate(transform.position, neighborhood, decorated);
+
+        std::lock_guard<std::mutex> guard(chunkMutex);
 
-	void Rebuild()
+        blocks = std::move(decorated);
+        blocks.Compact();
+
+        CalculateColumns();
+    }
+
+	static void Rebuild(const std::shared_ptr<Chunk>& chunk)
 	{
+        chunk->Mesh();
+
+        MainThreadExecutor::QueueTask([chunk]()
+        {
+            chunk->Upload();
+        });
+	}
+
+    void Mesh()
+    {
+        PaddedOccupancy occupancy = GatherOccupancy();
+
+        LightVolume lightVolume;
+        GatherLight(lightVolume);
+
+        std::unique_ptr<ChunkMesh> snapshot = std::make_unique<ChunkMesh>();
+
         std::lock_guard<std::mutex> guard(chunkMutex);
 
-		vertices.clear();
-		indices.clear();
-		indicesIndex = 0;
-
-		for (int x = 0; x < CHUNK_SIZE; ++x)
-		{
-			for (int y = 0; y < CHUNK_SIZE; ++y)
-			{
-				for (int z = 0; z < CHUNK_SIZE; ++z)
-				{
-                    if (blocks[x][y][z] == (int)BlockType::BLOCK_AIR)
-                        continue;
+        AddColumns(occupancy);
 
-                    std::array<glm::vec2, 6> textureCoordinates = BlockManager::GetBlockTexture((BlockType)blocks[x][y][z]);
+        snapshot->version = ++meshVersion;
+        snapshot->visible = !IsEmpty() && !IsEnclosed(occupancy);
 
-                    if (ShouldRenderFace(x, y, z, "top"))
-                        GenerateTopFace({x, y, z}, BlockManager::GetTextureCoordinates(textureCoordinates[0]));
+        if (snapshot->visible)
+            GenerateMesh(meshingMode, occupancy, lightVolume, snapshot->vertices);
 
-                    if (ShouldRenderFace(x, y, z, "bottom"))
-                        GenerateBottomFace({x, y, z}, BlockManager::GetTextureCoordinates(textureCoordinates[1]));
+        latestMesh = std::move(snapshot);
+    }
 
-                    if (ShouldRenderFace(x, y, z, "front"))
-                        GenerateFrontFace({x, y, z}, BlockManager::GetTextureCoordinates(textureCoordinates[2]));
+    void Upload()
+    {
+        if (unloaded)
+            return;
 
-                    if (ShouldRenderFace(x, y, z, "back"))
-                        GenerateBackFace({x, y, z}, BlockManager::GetTextureCoordinates(textureCoordinates[3]));
+        std::unique_ptr<ChunkMesh> snapshot;
+
+        {
+            std::lock_guard<std::mutex> guard(chunkMutex);
+            snapshot = std::move(latestMesh);
+        }
 
-                    if (ShouldRenderFace(x, y, z, "right"))
-                        GenerateRightFace({x, y, z}, BlockManager::GetTextureCoordinates(textureCoordinates[4]));
+        if (snapshot == nullptr || snapshot->version <= uploadedVersion)
+            return;
 
-                    if (ShouldRenderFace(x, y, z, "left"))
-                        GenerateLeftFace({x, y, z}, BlockManager::GetTextureCoordinates(textureCoordinates[5]));
-				}
-			}
-		}
+        uploadedVersion = snapshot->version;
 
-        MainThreadExecutor::QueueTask([this]()
+        if (!snapshot->visible)
         {
+            if (mesh != nullptr)
+                mesh->active = false;
 
-            mesh->RegisterData(vertices, indices);
+            return;
+        }
 
-            if (firstRebuild)
-            {
+        if (mesh == nullptr)
+        {
+            mesh = RenderableObject::Register(NameIDTag::Register(std::format("Chunk_{}_{}_{}", transform.position.x, transform.position.y, transform.position.z), this), {}, {}, "default");
+            mesh->transform = transform.ToTransform();
+            mesh->RegisterTexture("atlas");
+        }
 
-                mesh->Generate();
-                firstRebuild = false;
-            }
-            else
-                mesh->ReGenerate();
+        mesh->RegisterData(std::move(snapshot->vertices));
 
-            Renderer::RegisterObject(mesh);
-        });
-	}
+        mesh->active = true;
+
+        if (firstRebuild)
+        {
+            mesh->Generate();
+            firstRebuild = false;
+        }
+        else
+            mesh->ReGenerate();
 
-    bool HasBlock(const glm::ivec3& position)
+        Renderer::RegisterObject(mesh);
+    }
+
+    static void RegisterAtlasUniforms()
+    {
+        std::shared_ptr<ShaderObject> shader = ShaderManager::GetShader("default");
+        glm::vec2 atlasSize = BlockManager::atlas->GetAtlasSize();
+
+        shader->Use();
+        shader->SetUniform("atlasSlots", (float)BlockManager::atlas->GetSlotsPerRow());
+        shader->SetUniform("atlasSlotSize", glm::vec2((float)BlockManager::atlas->GetSlotSize()) / atlasSize);
+        shader->SetUniform("atlasTileSize", glm::vec2((float)BlockManager::atlas->tileSize) / atlasSize);
+        shader->SetUniform("atlasGutter", glm::vec2((float)BlockManager::atlas->gutter) / atlasSize);
+    }
+
+    std::pair<size_t, size_t> CountMesh(MeshingMode mode) const
+    {
+        PaddedOccupancy occupancy = GatherOccupancy();
+
+        LightVolume lightVolume;
+        GatherLight(lightVolume);
+
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        AddColumns(occupancy);
+
+        std::vector<ChunkVertex> vertices;
+
+        GenerateMesh(mode, occupancy, lightVolume, vertices);
+
+        return { vertices.size(), vertices.size() / 4 * 6 };
+    }
+
+    size_t GetBlockMemoryUsage() const
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        return blocks.GetMemoryUsage();
+    }
+
+    std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> GetColumns() const
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        return columns;
+    }
+
+    bool HasBlock(const glm::ivec3& position) const
     {
         if (position.x < 0 || position.x >= CHUNK_SIZE)
             return false;
@@ -122,26 +252,99 @@ public:
         if (position.z < 0 || position.z >= CHUNK_SIZE)
             return false;
 
-        return blocks[position.x][position.y][position.z] != (int)BlockType::BLOCK_AIR;
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        return (columns[position.x * CHUNK_SIZE + position.z] >> position.y) & 1;
+    }
+
+    BlockType GetBlock(const glm::ivec3& position) const
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        return blocks.Get(position.x, position.y, position.z);
     }
 
-    void SetBlock(const glm::ivec3& position, BlockType type)
+    uint16_t GetColumn(int x, int z) const
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        return columns[x * CHUNK_SIZE + z];
+    }
+
+    std::vector<std::pair<glm::ivec3, uint8_t>> GetLightSources() const
+    {
+        std::lock_guard<std::mutex> guard(chunkMutex);
+
+        std::vector<std::pair<glm::ivec3, uint8_t>> sources;
+
+        if (blocks.IsUniform() && BlockManager::GetLightEmission(blocks.Get(0, 0, 0)) == 0)
+            return sources;
+
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int y = 0; y < CHUNK_SIZE; ++y)
+            {
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                {
+                    uint8_t emission = BlockManager::GetLightEmission(blocks.Get(x, y, z));
+
+                    if (emission > 0)
+                        sources.push_back({ { x, y, z }, emission });
+                }
+            }
+        }
+
+        return sources;
+    }
+
+    uint8_t GetLight(const glm::ivec3& position, LightChannel channel) const
+    {
+        uint8_t value = light[GetLightIndex(position)];
+
+        return channel == LightChannel::SKY ? value >> 4 : value & 15;
+    }
+
+    void SetLight(const glm::ivec3& position, LightChannel channel, uint8_t level)
+    {
+        uint8_t& value = light[GetLightIndex(position)];
+
+        if (channel == LightChannel::SKY)
+            value = (uint8_t)((value & 15) | level << 4);
+        else
+            value = (uint8_t)((value & 240) | level);
+    }
+
+    void ClearLight()
+    {
+        light.fill(0);
+    }
+
+    bool SetBlock(const glm::ivec3& position, BlockType type)
     {
         if (position.x < 0 || position.x >= CHUNK_SIZE)
-            return;
+            return false;
 
         if (position.y < 0 || position.y >= CHUNK_SIZE)
-            return;
+            return false;
 
         if (position.z < 0 || position.z >= CHUNK_SIZE)
-            return;
+            return false;
 
-        if (blocks[position.x][position.y][position.z] == (int)type)
-            return;
+        {
+            std::lock_guard<std::mutex> guard(chunkMutex);
+
+            if (!blocks.Set(position.x, position.y, position.z, type))
+                return false;
 
-        blocks[position.x][position.y][position.z] = (int)type;
+            uint16_t& column = columns[position.x * CHUNK_SIZE + position.z];
+
+            if (type == BlockType::BLOCK_AIR)
+                column &= (uint16_t)~(1 << position.y);
+            else
+                column |= (uint16_t)(1 << position.y);
+        }
 
-        Rebuild();
+        return true;
     }
 
     static glm::ivec3 WorldToBlockCoordinates(const glm::vec3& worldPosition)
@@ -170,154 +373,455 @@ public:
         return { blockX, blockY, blockZ };
     }
 
-    void CleanUp() const
+    void CleanUp()
     {
-        Renderer::RemoveObject(mesh->name);
+        unloaded = true;
+
+        if (mesh != nullptr && !firstRebuild)
+            Renderer::RemoveObject(mesh->name);
     }
 
 	TransformI transform;
 	std::shared_ptr<RenderableObject> mesh;
 
+    std::atomic<ChunkStage> stage = ChunkStage::NONE;
+    bool stageRunning = false;
+    std::atomic<bool> rebuildQueued = false;
+    std::atomic<bool> meshDirty = false;
+    bool unloaded = false;
+
+    bool hasLight = false;
+
+    static inline std::shared_mutex lightMutex;
+    static inline std::atomic<MeshingMode> meshingMode = MeshingMode::GREEDY;
+
 private:
 
     mutable std::mutex chunkMutex;
-	std::vector<Vertex> vertices = {};
-	std::vector<unsigned int> indices = {};
 
-	int indicesIndex = 0;
+    std::unique_ptr<ChunkMesh> latestMesh;
+    uint64_t meshVersion = 0;
+    uint64_t uploadedVersion = 0;
+
 	bool firstRebuild = true;
 
-	unsigned int blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SIZE];
+	BlockStorage<CHUNK_SIZE> blocks;
+    std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> columns = {};
+    std::array<uint8_t, CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE> light = {};
+
+    ThreadedChunkMap* chunkMap = nullptr;
 
-    bool ShouldRenderFace(int x, int y, int z, const std::string& face)
+    void CalculateColumns()
     {
-        if (face == "top")
-            return y == CHUNK_SIZE - 1 || blocks[x][y + 1][z] == (int)BlockType::BLOCK_AIR;
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                uint16_t column = 0;
 
-        if (face == "bottom")
-            return y == 0 || blocks[x][y - 1][z] == (int)BlockType::BLOCK_AIR;
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                    column |= (uint16_t)(blocks.Get(x, y, z) != BlockType::BLOCK_AIR) << y;
 
-        if (face == "front")
-            return z == CHUNK_SIZE - 1 || blocks[x][y][z + 1] == (int)BlockType::BLOCK_AIR;
+                columns[x * CHUNK_SIZE + z] = column;
+            }
+        }
+    }
 
-        if (face == "back")
-            return z == 0 || blocks[x][y][z - 1] == (int)BlockType::BLOCK_AIR;
+    bool IsEmpty() const
+    {
+        return std::all_of(columns.begin(), columns.end(), [](uint16_t column) { return column == 0; });
+    }
 
-        if (face == "right")
-            return x == CHUNK_SIZE - 1 || blocks[x + 1][y][z] == (int)BlockType::BLOCK_AIR;
+    bool IsEnclosed(const PaddedOccupancy& occupancy) const
+    {
+        for (int x = -1; x <= CHUNK_SIZE; ++x)
+        {
+            for (int z = -1; z <= CHUNK_SIZE; ++z)
+            {
+                bool insideX = x >= 0 && x < CHUNK_SIZE;
+                bool insideZ = z >= 0 && z < CHUNK_SIZE;
+
+                if (!insideX && !insideZ)
+                    continue;
 
-        if (face == "left")
-            return x == 0 || blocks[x - 1][y][z] == (int)BlockType::BLOCK_AIR;
-       
-        return false;
+                uint32_t required = insideX && insideZ ? (1u << (CHUNK_SIZE + 2)) - 1 : ((1u << CHUNK_SIZE) - 1) << 1;
+
+                if ((occupancy[PaddedColumnIndex(x, z)] & required) != required)
+                    return false;
+            }
+        }
+
+        return true;
     }
 
-    void GenerateTopFace(const glm::vec3& position, const std::array<glm::vec2, 4>& uvs)
+    PaddedOccupancy GatherOccupancy() const
     {
-        vertices.push_back(Vertex::Register({0.0f + position.x, 1.0f + position.y, 1.0f + position.z}, uvs[0]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 1.0f + position.y, 0.0f + position.z}, uvs[1]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 1.0f + position.y, 0.0f + position.z}, uvs[2]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 1.0f + position.y, 1.0f + position.z}, uvs[3]));
+        PaddedOccupancy occupancy = {};
+
+        if (chunkMap == nullptr)
+            return occupancy;
+
+        glm::ivec3 chunkCoordinates = transform.position / CHUNK_SIZE;
+
+        for (int chunkX = -1; chunkX <= 1; ++chunkX)
+        {
+            for (int chunkY = -1; chunkY <= 1; ++chunkY)
+            {
+                for (int chunkZ = -1; chunkZ <= 1; ++chunkZ)
+                {
+                    if (chunkX == 0 && chunkY == 0 && chunkZ == 0)
+                        continue;
+
+                    std::shared_ptr<Chunk> neighbor = chunkMap->GetChunk(chunkCoordinates + glm::ivec3(chunkX, chunkY, chunkZ));
+
+                    if (neighbor == nullptr)
+                        continue;
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 2);
-        indices.push_back(indicesIndex + 1);
+                    std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> neighborColumns = neighbor->GetColumns();
+
+                    int startX = chunkX < 0 ? -1 : chunkX > 0 ? CHUNK_SIZE : 0;
+                    int startZ = chunkZ < 0 ? -1 : chunkZ > 0 ? CHUNK_SIZE : 0;
+                    int endX = chunkX == 0 ? CHUNK_SIZE : startX + 1;
+                    int endZ = chunkZ == 0 ? CHUNK_SIZE : startZ + 1;
+
+                    for (int x = startX; x < endX; ++x)
+                    {
+                        for (int z = startZ; z < endZ; ++z)
+                        {
+                            uint32_t column = neighborColumns[(x - chunkX * CHUNK_SIZE) * CHUNK_SIZE + z - chunkZ * CHUNK_SIZE];
+
+                            if (chunkY < 0)
+                                column = (column >> (CHUNK_SIZE - 1)) & 1;
+                            else if (chunkY > 0)
+                                column = (column & 1) << (CHUNK_SIZE + 1);
+                            else
+                                column <<= 1;
+
+                            occupancy[PaddedColumnIndex(x, z)] |= column;
+                        }
+                    }
+                }
+            }
+        }
+
+        return occupancy;
+    }
+
+    void AddColumns(PaddedOccupancy& occupancy) const
+    {
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                occupancy[PaddedColumnIndex(x, z)] |= (uint32_t)columns[x * CHUNK_SIZE + z] << 1;
+        }
+    }
+
+    void GatherLight(LightVolume& lightVolume) const
+    {
+        lightVolume.fill(15);
+
+        std::array<std::shared_ptr<Chunk>, 6> neighbors = {};
+
+        if (chunkMap != nullptr)
+        {
+            glm::ivec3 chunkCoordinates = transform.position / CHUNK_SIZE;
+
+            for (int face = 0; face < 6; ++face)
+                neighbors[face] = chunkMap->GetChunk(chunkCoordinates + FACE_NORMALS[face]);
+        }
+
+        std::shared_lock<std::shared_mutex> guard(lightMutex);
+
+        if (hasLight)
+        {
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                {
+                    for (int z = 0; z < CHUNK_SIZE; ++z)
+                        lightVolume[GetPaddedLightIndex({ x, y, z })] = GetCombinedLight({ x, y, z });
+                }
+            }
+        }
+
+        for (int face = 0; face < 6; ++face)
+        {
+            const std::shared_ptr<Chunk>& neighbor = neighbors[face];
+
+            if (neighbor == nullptr || !neighbor->hasLight)
+                continue;
+
+            int axis = FACE_AXES[face];
+            glm::ivec3 normal = FACE_NORMALS[face];
+
+            for (int u = 0; u < CHUNK_SIZE; ++u)
+            {
+                for (int v = 0; v < CHUNK_SIZE; ++v)
+                {
+                    glm::ivec3 position = {};
+
+                    position[axis] = normal[axis] > 0 ? CHUNK_SIZE : -1;
+                    position[(axis + 1) % 3] = u;
+                    position[(axis + 2) % 3] = v;
+
+                    lightVolume[GetPaddedLightIndex(position)] = neighbor->GetCombinedLight(position - normal * CHUNK_SIZE);
+                }
+            }
+        }
+    }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 3);
-        indices.push_back(indicesIndex + 2);
+    uint8_t GetCombinedLight(const glm::ivec3& position) const
+    {
+        uint8_t value = light[GetLightIndex(position)];
 
-        indicesIndex += 4;
+        return std::max<uint8_t>(value >> 4, value & 15);
     }
 
-    void GenerateBottomFace(const glm::vec3& position, const std::array<glm::vec2, 4>& uvs)
+    static int GetLightIndex(const glm::ivec3& position)
     {
-        vertices.push_back(Vertex::Register({0.0f + position.x, 0.0f + position.y, 0.0f + position.z}, uvs[0]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 0.0f + position.y, 0.0f + position.z}, uvs[1]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 0.0f + position.y, 1.0f + position.z}, uvs[2]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 0.0f + position.y, 1.0f + position.z}, uvs[3]));
+        return (position.x * CHUNK_SIZE + position.z) * CHUNK_SIZE + position.y;
+    }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 1);
-        indices.push_back(indicesIndex + 2);
+    static int GetPaddedLightIndex(const glm::ivec3& position)
+    {
+        return ((position.x + 1) * (CHUNK_SIZE + 2) + position.z + 1) * (CHUNK_SIZE + 2) + position.y + 1;
+    }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 2);
-        indices.push_back(indicesIndex + 3);
+    void GenerateFaceMasks(const PaddedOccupancy& occupancy, FaceMasks& faceMasks) const
+    {
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                uint32_t column = occupancy[PaddedColumnIndex(x, z)];
+                int index = x * CHUNK_SIZE + z;
+
+                faceMasks[0][index] = (uint16_t)((column & ~(column >> 1)) >> 1);
+                faceMasks[1][index] = (uint16_t)((column & ~(column << 1)) >> 1);
+                faceMasks[2][index] = (uint16_t)((column & ~occupancy[PaddedColumnIndex(x, z + 1)]) >> 1);
+                faceMasks[3][index] = (uint16_t)((column & ~occupancy[PaddedColumnIndex(x, z - 1)]) >> 1);
+                faceMasks[4][index] = (uint16_t)((column & ~occupancy[PaddedColumnIndex(x + 1, z)]) >> 1);
+                faceMasks[5][index] = (uint16_t)((column & ~occupancy[PaddedColumnIndex(x - 1, z)]) >> 1);
+            }
+        }
+    }
 
-        indicesIndex += 4;
+    static bool IsOccupied(const PaddedOccupancy& occupancy, const glm::ivec3& position)
+    {
+        return (occupancy[PaddedColumnIndex(position.x, position.z)] >> (position.y + 1)) & 1;
     }
 
-    void GenerateFrontFace(const glm::vec3& position, const std::array<glm::vec2, 4>& uvs)
+    static int GetAmbientOcclusion(const PaddedOccupancy& occupancy, int face, const glm::ivec3& position)
     {
-        vertices.push_back(Vertex::Register({0.0f + position.x, 0.0f + position.y, 1.0f + position.z}, uvs[0]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 0.0f + position.y, 1.0f + position.z}, uvs[1]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 1.0f + position.y, 1.0f + position.z}, uvs[2]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 1.0f + position.y, 1.0f + position.z}, uvs[3]));
+        int axis = FACE_AXES[face];
+        glm::ivec3 front = position + FACE_NORMALS[face];
+
+        int occlusion = 0;
+
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            glm::ivec3 direction = FACE_CORNERS[face][corner] * 2 - 1;
+            glm::ivec3 firstSide = {};
+            glm::ivec3 secondSide = {};
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 1);
-        indices.push_back(indicesIndex + 2);
+            firstSide[(axis + 1) % 3] = direction[(axis + 1) % 3];
+            secondSide[(axis + 2) % 3] = direction[(axis + 2) % 3];
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 2);
-        indices.push_back(indicesIndex + 3);
+            int first = IsOccupied(occupancy, front + firstSide);
+            int second = IsOccupied(occupancy, front + secondSide);
+            int diagonal = IsOccupied(occupancy, front + firstSide + secondSide);
 
-        indicesIndex += 4;
+            occlusion |= (first && second ? 0 : 3 - (first + second + diagonal)) << (corner * 2);
+        }
+
+        return occlusion;
     }
 
-    void GenerateBackFace(const glm::vec3& position, const std::array<glm::vec2, 4>& uvs)
+    static int PaddedColumnIndex(int x, int z)
     {
-        vertices.push_back(Vertex::Register({1.0f + position.x, 0.0f + position.y, 0.0f + position.z}, uvs[0]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 0.0f + position.y, 0.0f + position.z}, uvs[1]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 1.0f + position.y, 0.0f + position.z}, uvs[2]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 1.0f + position.y, 0.0f + position.z}, uvs[3]));
+        return (x + 1) * (CHUNK_SIZE + 2) + (z + 1);
+    }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 1);
-        indices.push_back(indicesIndex + 2);
+    void GenerateMesh(MeshingMode mode, const PaddedOccupancy& occupancy, const LightVolume& lightVolume, std::vector<ChunkVertex>& vertices) const
+    {
+        vertices.clear();
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 2);
-        indices.push_back(indicesIndex + 3);
+        FaceMasks faceMasks;
+        GenerateFaceMasks(occupancy, faceMasks);
 
-        indicesIndex += 4;
+        if (mode == MeshingMode::GREEDY)
+        {
+            GenerateGreedyMesh(faceMasks, occupancy, lightVolume, vertices);
+            return;
+        }
+
+        for (int face = 0; face < 6; ++face)
+        {
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                {
+                    for (uint16_t bits = faceMasks[face][x * CHUNK_SIZE + z]; bits != 0; bits &= bits - 1)
+                    {
+                        int y = std::countr_zero(bits);
+                        int tile = BlockManager::GetBlockTile(blocks.Get(x, y, z), face);
+                        int light = lightVolume[GetPaddedLightIndex(glm::ivec3(x, y, z) + FACE_NORMALS[face])];
+                        int occlusion = GetAmbientOcclusion(occupancy, face, { x, y, z });
+
+                        GenerateFace(face, vertices, { x, y, z }, { 1, 1, 1 }, tile, light, occlusion);
+                    }
+                }
+            }
+        }
     }
 
-    void GenerateRightFace(const glm::vec3& position, const std::array<glm::vec2, 4>& uvs)
+    void GenerateGreedyMesh(const FaceMasks& faceMasks, const PaddedOccupancy& occupancy, const LightVolume& lightVolume, std::vector<ChunkVertex>& vertices) const
     {
-        vertices.push_back(Vertex::Register({1.0f + position.x, 0.0f + position.y, 1.0f + position.z}, uvs[0]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 0.0f + position.y, 0.0f + position.z}, uvs[1]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 1.0f + position.y, 0.0f + position.z}, uvs[2]));
-        vertices.push_back(Vertex::Register({1.0f + position.x, 1.0f + position.y, 1.0f + position.z}, uvs[3]));
+        for (int face = 0; face < 6; ++face)
+        {
+            int axis = FACE_AXES[face];
+            int uAxis = (axis + 1) % 3;
+            int vAxis = (axis + 2) % 3;
+
+            uint32_t slices[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SIZE] = {};
+
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                {
+                    for (uint16_t bits = faceMasks[face][x * CHUNK_SIZE + z]; bits != 0; bits &= bits - 1)
+                    {
+                        glm::ivec3 position = { x, std::countr_zero(bits), z };
+                        int tile = BlockManager::GetBlockTile(blocks.Get(position.x, position.y, position.z), face);
+                        int light = lightVolume[GetPaddedLightIndex(position + FACE_NORMALS[face])];
+                        int occlusion = GetAmbientOcclusion(occupancy, face, position);
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 1);
-        indices.push_back(indicesIndex + 2);
+                        slices[position[axis]][position[vAxis]][position[uAxis]] = (uint32_t)((tile + 1) | light << 9 | occlusion << 13);
+                    }
+                }
+            }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 2);
-        indices.push_back(indicesIndex + 3);
+            for (int slice = 0; slice < CHUNK_SIZE; ++slice)
+            {
+                auto& mask = slices[slice];
 
-        indicesIndex += 4;
+                for (int v = 0; v < CHUNK_SIZE; ++v)
+                {
+                    for (int u = 0; u < CHUNK_SIZE;)
+                    {
+                        uint32_t key = mask[v][u];
+
+                        if (key == 0)
+                        {
+                            ++u;
+                            continue;
+                        }
+
+                        int width = 1;
+
+                        while (u + width < CHUNK_SIZE && mask[v][u + width] == key)
+                            ++width;
+
+                        int height = 1;
+
+                        for (; v + height < CHUNK_SIZE; ++height)
+                        {
+                            bool rowMatches = true;
+
+                            for (int i = 0; i < width && rowMatches; ++i)
+                                rowMatches = mask[v + height][u + i] == key;
+
+                            if (!rowMatches)
+                                break;
+                        }
+
+                        for (int j = 0; j < height; ++j)
+                        {
+                            for (int i = 0; i < width; ++i)
+                                mask[v + j][u + i] = 0;
+                        }
+
+                        glm::ivec3 position = {};
+                        glm::ivec3 size = { 1, 1, 1 };
+
+                        position[axis] = slice;
+                        position[uAxis] = u;
+                        position[vAxis] = v;
+
+                        size[uAxis] = width;
+                        size[vAxis] = height;
+
+                        GenerateFace(face, vertices, position, size, (int)(key & 511) - 1, (int)(key >> 9) & 15, (int)(key >> 13));
+
+                        u += width;
+                    }
+                }
+            }
+        }
     }
 
-    void GenerateLeftFace(const glm::vec3& position, const std::array<glm::vec2, 4>& uvs)
+    static void GenerateFace(int face, std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
     {
-        vertices.push_back(Vertex::Register({0.0f + position.x, 0.0f + position.y, 0.0f + position.z}, uvs[0]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 0.0f + position.y, 1.0f + position.z}, uvs[1]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 1.0f + position.y, 1.0f + position.z}, uvs[2]));
-        vertices.push_back(Vertex::Register({0.0f + position.x, 1.0f + position.y, 0.0f + position.z}, uvs[3]));
+        switch (face)
+        {
+        case 0: GenerateTopFace(vertices, position, size, tile, light, occlusion); break;
+        case 1: GenerateBottomFace(vertices, position, size, tile, light, occlusion); break;
+        case 2: GenerateFrontFace(vertices, position, size, tile, light, occlusion); break;
+        case 3: GenerateBackFace(vertices, position, size, tile, light, occlusion); break;
+        case 4: GenerateRightFace(vertices, position, size, tile, light, occlusion); break;
+        case 5: GenerateLeftFace(vertices, position, size, tile, light, occlusion); break;
+        }
+
+        if ((occlusion & 3) + ((occlusion >> 4) & 3) < ((occlusion >> 2) & 3) + ((occlusion >> 6) & 3))
+            std::rotate(vertices.end() - 4, vertices.end() - 3, vertices.end());
+    }
+
+    static void GenerateTopFace(std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
+    {
+        vertices.push_back(ChunkVertex::Register({position.x, size.y + position.y, size.z + position.z}, 0, tile, light, occlusion & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, size.y + position.y, size.z + position.z}, 0, tile, light, (occlusion >> 2) & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, size.y + position.y, position.z}, 0, tile, light, (occlusion >> 4) & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, size.y + position.y, position.z}, 0, tile, light, (occlusion >> 6) & 3));
+    }
+
+    static void GenerateBottomFace(std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
+    {
+        vertices.push_back(ChunkVertex::Register({position.x, position.y, position.z}, 1, tile, light, occlusion & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, position.y, position.z}, 1, tile, light, (occlusion >> 2) & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, position.y, size.z + position.z}, 1, tile, light, (occlusion >> 4) & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, position.y, size.z + position.z}, 1, tile, light, (occlusion >> 6) & 3));
+    }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 1);
-        indices.push_back(indicesIndex + 2);
+    static void GenerateFrontFace(std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
+    {
+        vertices.push_back(ChunkVertex::Register({position.x, position.y, size.z + position.z}, 2, tile, light, occlusion & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, position.y, size.z + position.z}, 2, tile, light, (occlusion >> 2) & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, size.y + position.y, size.z + position.z}, 2, tile, light, (occlusion >> 4) & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, size.y + position.y, size.z + position.z}, 2, tile, light, (occlusion >> 6) & 3));
+    }
+
+    static void GenerateBackFace(std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
+    {
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, position.y, position.z}, 3, tile, light, occlusion & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, position.y, position.z}, 3, tile, light, (occlusion >> 2) & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, size.y + position.y, position.z}, 3, tile, light, (occlusion >> 4) & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, size.y + position.y, position.z}, 3, tile, light, (occlusion >> 6) & 3));
+    }
 
-        indices.push_back(indicesIndex);
-        indices.push_back(indicesIndex + 2);
-        indices.push_back(indicesIndex + 3);
+    static void GenerateRightFace(std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
+    {
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, position.y, size.z + position.z}, 4, tile, light, occlusion & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, position.y, position.z}, 4, tile, light, (occlusion >> 2) & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, size.y + position.y, position.z}, 4, tile, light, (occlusion >> 4) & 3));
+        vertices.push_back(ChunkVertex::Register({size.x + position.x, size.y + position.y, size.z + position.z}, 4, tile, light, (occlusion >> 6) & 3));
+    }
 
-        indicesIndex += 4;
+    static void GenerateLeftFace(std::vector<ChunkVertex>& vertices, const glm::ivec3& position, const glm::ivec3& size, int tile, int light, int occlusion)
+    {
+        vertices.push_back(ChunkVertex::Register({position.x, position.y, position.z}, 5, tile, light, occlusion & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, position.y, size.z + position.z}, 5, tile, light, (occlusion >> 2) & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, size.y + position.y, size.z + position.z}, 5, tile, light, (occlusion >> 4) & 3));
+        vertices.push_back(ChunkVertex::Register({position.x, size.y + position.y, position.z}, 5, tile, light, (occlusion >> 6) & 3));
     }
 };
 
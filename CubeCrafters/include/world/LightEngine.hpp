@@ -0,0 +1,347 @@
+#ifndef LIGHT_ENGINE_HPP
+#define LIGHT_ENGINE_HPP
+
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <glm/glm.hpp>
+#include "thread/ThreadedChunkMap.hpp"
+#include "world/Chunk.hpp"
+
+namespace LightEngine
+{
+    const int CHUNK_SHIFT = std::countr_zero((unsigned int)CHUNK_SIZE);
+    const uint8_t MAX_LIGHT = 15;
+    const glm::ivec3 DOWN = { 0, -1, 0 };
+
+    std::atomic<int> skyHeight = std::numeric_limits<int>::max();
+
+    struct LightNode
+    {
+        glm::ivec3 position;
+        uint8_t level;
+    };
+
+    class LightContext
+    {
+
+    public:
+
+        explicit LightContext(ThreadedChunkMap& chunkMap) : chunkMap(chunkMap)
+        {
+
+        }
+
+        Chunk* GetChunk(const glm::ivec3& chunkCoordinates)
+        {
+            if (last != nullptr && chunkCoordinates == lastCoordinates)
+                return last;
+
+            auto iterator = chunks.find(chunkCoordinates);
+
+            if (iterator == chunks.end())
+                iterator = chunks.insert({ chunkCoordinates, chunkMap.GetChunk(chunkCoordinates) }).first;
+
+            lastCoordinates = chunkCoordinates;
+            last = iterator->second.get();
+
+            return last;
+        }
+
+        Chunk* GetLitChunk(const glm::ivec3& worldPosition, glm::ivec3& localPosition)
+        {
+            Chunk* chunk = GetChunk(worldPosition >> CHUNK_SHIFT);
+
+            if (chunk == nullptr || !chunk->hasLight)
+                return nullptr;
+
+            localPosition = worldPosition & (CHUNK_SIZE - 1);
+
+            return chunk;
+        }
+
+        uint8_t GetLight(const glm::ivec3& worldPosition, LightChannel channel)
+        {
+            glm::ivec3 localPosition;
+            Chunk* chunk = GetLitChunk(worldPosition, localPosition);
+
+            return chunk != nullptr ? chunk->GetLight(localPosition, channel) : 0;
+        }
+
+        void SetLight(const glm::ivec3& worldPosition, LightChannel channel, uint8_t level)
+        {
+            glm::ivec3 localPosition;
+            Chunk* chunk = GetLitChunk(worldPosition, localPosition);
+
+            if (chunk == nullptr)
+                return;
+
+            chunk->SetLight(localPosition, channel, level);
+
+            glm::ivec3 chunkCoordinates = worldPosition >> CHUNK_SHIFT;
+            changedChunks.insert(chunkCoordinates);
+
+            for (int face = 0; face < 6; ++face)
+            {
+                int axis = FACE_AXES[face];
+                int edge = FACE_NORMALS[face][axis] > 0 ? CHUNK_SIZE - 1 : 0;
+
+                if (localPosition[axis] == edge)
+                    changedChunks.insert(chunkCoordinates + FACE_NORMALS[face]);
+            }
+        }
+
+        std::unordered_set<glm::ivec3> changedChunks;
+
+    private:
+
+        ThreadedChunkMap& chunkMap;
+        std::unordered_map<glm::ivec3, std::shared_ptr<Chunk>> chunks;
+
+        glm::ivec3 lastCoordinates = {};
+        Chunk* last = nullptr;
+    };
+
+    bool IsOpaque(Chunk& chunk, const glm::ivec3& localPosition)
+    {
+        return chunk.HasBlock(localPosition);
+    }
+
+    uint8_t GetPropagatedLevel(LightChannel channel, const glm::ivec3& direction, uint8_t level)
+    {
+        if (channel == LightChannel::SKY && direction == DOWN && level == MAX_LIGHT)
+            return MAX_LIGHT;
+
+        return level - 1;
+    }
+
+    void Propagate(LightContext& context, LightChannel channel, std::vector<LightNode>& queue)
+    {
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            LightNode node = queue[i];
+
+            if (node.level <= 1)
+                continue;
+
+            for (const glm::ivec3& direction : FACE_NORMALS)
+            {
+                glm::ivec3 position = node.position + direction;
+                glm::ivec3 localPosition;
+                Chunk* chunk = context.GetLitChunk(position, localPosition);
+
+                if (chunk == nullptr || IsOpaque(*chunk, localPosition))
+                    continue;
+
+                uint8_t level = GetPropagatedLevel(channel, direction, node.level);
+
+                if (chunk->GetLight(localPosition, channel) >= level)
+                    continue;
+
+                context.SetLight(position, channel, level);
+                queue.push_back({ position, level });
+            }
+        }
+
+        queue.clear();
+    }
+
+    void Unpropagate(LightContext& context, LightChannel channel, std::vector<LightNode>& queue, std::vector<LightNode>& propagationQueue)
+    {
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            LightNode node = queue[i];
+
+            for (const glm::ivec3& direction : FACE_NORMALS)
+            {
+                glm::ivec3 position = node.position + direction;
+                glm::ivec3 localPosition;
+                Chunk* chunk = context.GetLitChunk(position, localPosition);
+
+                if (chunk == nullptr)
+                    continue;
+
+                uint8_t level = chunk->GetLight(localPosition, channel);
+
+                if (level == 0)
+                    continue;
+
+                if (level < node.level || (channel == LightChannel::SKY && direction == DOWN && node.level == MAX_LIGHT))
+                {
+                    context.SetLight(position, channel, 0);
+                    queue.push_back({ position, level });
+
+                    uint8_t emission = channel == LightChannel::BLOCK ? BlockManager::GetLightEmission(chunk->GetBlock(localPosition)) : 0;
+
+                    if (emission > 0)
+                    {
+                        context.SetLight(position, channel, emission);
+                        propagationQueue.push_back({ position, emission });
+                    }
+                }
+                else
+                    propagationQueue.push_back({ position, level });
+            }
+        }
+
+        queue.clear();
+    }
+
+    bool IsOpenToSky(LightContext& context, glm::ivec3 chunkCoordinates, int x, int z)
+    {
+        while (true)
+        {
+            Chunk* chunk = context.GetChunk(chunkCoordinates);
+
+            if (chunk == nullptr)
+                return chunkCoordinates.y * CHUNK_SIZE >= skyHeight;
+
+            if (chunk->hasLight)
+                return chunk->GetLight({ x, 0, z }, LightChannel::SKY) == MAX_LIGHT;
+
+            if (chunk->GetColumn(x, z) != 0)
+                return false;
+
+            chunkCoordinates.y++;
+        }
+    }
+
+    std::unordered_set<glm::ivec3> LightChunk(ThreadedChunkMap& chunkMap, const glm::ivec3& chunkCoordinates)
+    {
+        std::unique_lock<std::shared_mutex> guard(Chunk::lightMutex);
+
+        LightContext context(chunkMap);
+        Chunk* chunk = context.GetChunk(chunkCoordinates);
+
+        if (chunk == nullptr)
+            return {};
+
+        chunk->ClearLight();
+        chunk->hasLight = true;
+
+        glm::ivec3 origin = chunkCoordinates * CHUNK_SIZE;
+
+        std::vector<LightNode> skyQueue;
+        std::vector<LightNode> blockQueue;
+
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                glm::ivec3 position = { x, CHUNK_SIZE - 1, z };
+
+                if (IsOpaque(*chunk, position) || !IsOpenToSky(context, chunkCoordinates + glm::ivec3(0, 1, 0), x, z))
+                    continue;
+
+                chunk->SetLight(position, LightChannel::SKY, MAX_LIGHT);
+                skyQueue.push_back({ origin + position, MAX_LIGHT });
+            }
+        }
+
+        for (int face = 0; face < 6; ++face)
+        {
+            glm::ivec3 normal = FACE_NORMALS[face];
+            Chunk* neighbor = context.GetChunk(chunkCoordinates + normal);
+
+            if (neighbor == nullptr || !neighbor->hasLight)
+                continue;
+
+            int axis = FACE_AXES[face];
+
+            for (int u = 0; u < CHUNK_SIZE; ++u)
+            {
+                for (int v = 0; v < CHUNK_SIZE; ++v)
+                {
+                    glm::ivec3 position = {};
+
+                    position[axis] = normal[axis] > 0 ? 0 : CHUNK_SIZE - 1;
+                    position[(axis + 1) % 3] = u;
+                    position[(axis + 2) % 3] = v;
+
+                    glm::ivec3 worldPosition = origin + normal * CHUNK_SIZE + position;
+
+                    if (uint8_t level = neighbor->GetLight(position, LightChannel::SKY); level > 0)
+                        skyQueue.push_back({ worldPosition, level });
+
+                    if (uint8_t level = neighbor->GetLight(position, LightChannel::BLOCK); level > 0)
+                        blockQueue.push_back({ worldPosition, level });
+                }
+            }
+        }
+
+        for (const auto& [position, emission] : chunk->GetLightSources())
+        {
+            chunk->SetLight(position, LightChannel::BLOCK, emission);
+            blockQueue.push_back({ origin + position, emission });
+        }
+
+        Propagate(context, LightChannel::SKY, skyQueue);
+        Propagate(context, LightChannel::BLOCK, blockQueue);
+
+        context.changedChunks.erase(chunkCoordinates);
+
+        return std::move(context.changedChunks);
+    }
+
+    std::unordered_set<glm::ivec3> UpdateBlock(ThreadedChunkMap& chunkMap, const glm::ivec3& worldPosition, BlockType previous, BlockType current)
+    {
+        std::unique_lock<std::shared_mutex> guard(Chunk::lightMutex);
+
+        LightContext context(chunkMap);
+        glm::ivec3 localPosition;
+
+        if (context.GetLitChunk(worldPosition, localPosition) == nullptr)
+            return {};
+
+        std::vector<LightNode> removalQueue;
+        std::vector<LightNode> propagationQueue;
+
+        for (LightChannel channel : { LightChannel::SKY, LightChannel::BLOCK })
+        {
+            uint8_t level = context.GetLight(worldPosition, channel);
+
+            if (level > 0 && (current != BlockType::BLOCK_AIR || (channel == LightChannel::BLOCK && BlockManager::GetLightEmission(previous) > 0)))
+            {
+                context.SetLight(worldPosition, channel, 0);
+                removalQueue.push_back({ worldPosition, level });
+
+                Unpropagate(context, channel, removalQueue, propagationQueue);
+            }
+
+            if (current == BlockType::BLOCK_AIR)
+            {
+                for (const glm::ivec3& direction : FACE_NORMALS)
+                {
+                    if (uint8_t neighborLevel = context.GetLight(worldPosition + direction, channel); neighborLevel > 0)
+                        propagationQueue.push_back({ worldPosition + direction, neighborLevel });
+                }
+
+                glm::ivec3 above = worldPosition + glm::ivec3(0, 1, 0);
+                glm::ivec3 aboveLocal = above & (CHUNK_SIZE - 1);
+
+                if (channel == LightChannel::SKY && localPosition.y == CHUNK_SIZE - 1 && IsOpenToSky(context, above >> CHUNK_SHIFT, aboveLocal.x, aboveLocal.z))
+                {
+                    context.SetLight(worldPosition, channel, MAX_LIGHT);
+                    propagationQueue.push_back({ worldPosition, MAX_LIGHT });
+                }
+            }
+
+            uint8_t emission = channel == LightChannel::BLOCK ? BlockManager::GetLightEmission(current) : 0;
+
+            if (emission > 0)
+            {
+                context.SetLight(worldPosition, channel, emission);
+                propagationQueue.push_back({ worldPosition, emission });
+            }
+
+            Propagate(context, channel, propagationQueue);
+        }
+
+        return std::move(context.changedChunks);
+    }
+}
+
+#endif // !LIGHT_ENGINE_HPP
\ No newline at end of file
@@ -0,0 +1,354 @@
+#ifndef TERRAIN_GENERATOR_HPP
+#define TERRAIN_GENERATOR_HPP
+
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <format>
+#include "core/Logger.hpp"
+#include "math/Noise.hpp"
+#include "world/BlockManager.hpp"
+#include "world/BlockStorage.hpp"
+
+class BlockReader
+{
+
+public:
+
+    virtual ~BlockReader() = default;
+
+    virtual BlockType GetBlock(const glm::ivec3& worldPosition) const = 0;
+};
+
+class TerrainGenerator
+{
+
+public:
+
+    virtual ~TerrainGenerator() = default;
+
+    virtual void GenerateTerrain(const glm::ivec3& position, BlockStorage<CHUNK_SIZE>& blocks) const = 0;
+
+    virtual void Carve(const glm::ivec3& position, BlockStorage<CHUNK_SIZE>& blocks) const
+    {
+
+    }
+
+    virtual void Decorate(const glm::ivec3& position, const BlockReader& neighborhood, BlockStorage<CHUNK_SIZE>& blocks) const
+    {
+
+    }
+
+    virtual int GetMaxHeight() const
+    {
+        return std::numeric_limits<int>::max();
+    }
+
+    virtual void LogBenchmark() const
+    {
+
+    }
+};
+
+using DensityField = std::array<float, CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE>;
+
+class NoiseTerrainGenerator : public TerrainGenerator
+{
+
+public:
+
+    static constexpr int CaveLatticeStep = 4;
+    static constexpr int MaxTreeHeight = 6;
+
+    uint32_t seed;
+    NoiseSettings settings;
+    NoiseSettings caveSettings = { 0.035f, 2, 2.0f, 0.5f };
+
+    int baseHeight = 12;
+    int heightScale = 10;
+    int dirtDepth = 3;
+    float caveThreshold = 0.09f;
+    int treeAttempts = 3;
+    int treeChance = 40;
+
+    explicit NoiseTerrainGenerator(uint32_t seed) : seed(seed)
+    {
+
+    }
+
+    void GenerateTerrain(const glm::ivec3& position, BlockStorage<CHUNK_SIZE>& blocks) const override
+    {
+        Noise::Grid heights;
+        Noise::SampleGrid({ position.x, position.z }, seed, settings, heights);
+
+        std::array<int, CHUNK_SIZE * CHUNK_SIZE> surface;
+
+        for (int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+            surface[i] = baseHeight + (int)std::floor(heights[i] * heightScale);
+
+        auto [minimum, maximum] = std::minmax_element(surface.begin(), surface.end());
+
+        if (position.y > *maximum)
+            return;
+
+        if (position.y + CHUNK_SIZE <= *minimum - dirtDepth)
+        {
+            blocks.Fill(BlockType::BLOCK_STONE);
+            return;
+        }
+
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                int height = surface[z * CHUNK_SIZE + x];
+
+                for (int y = 0; y < CHUNK_SIZE && position.y + y <= height; ++y)
+                {
+                    int worldY = position.y + y;
+
+                    if (worldY == height)
+                        blocks.Set(x, y, z, BlockType::BLOCK_GRASS);
+                    else if (worldY >= height - dirtDepth)
+                        blocks.Set(x, y, z, BlockType::BLOCK_DIRT);
+                    else
+                        blocks.Set(x, y, z, BlockType::BLOCK_STONE);
+                }
+            }
+        }
+
+        blocks.Compact();
+    }
+
+    int GetMaxHeight() const override
+    {
+        float amplitude = 1.0f, amplitudeSum = 0.0f;
+
+        for (int octave = 0; octave < settings.octaves; ++octave)
+        {
+            amplitudeSum += amplitude;
+            amplitude *= settings.persistence;
+        }
+
+        return baseHeight + (int)std::ceil(amplitudeSum * heightScale) + MaxTreeHeight + 1;
+    }
+
+    void Carve(const glm::ivec3& position, BlockStorage<CHUNK_SIZE>& blocks) const override
+    {
+        if (blocks.IsUniform() && blocks.Get(0, 0, 0) == BlockType::BLOCK_AIR)
+            return;
+
+        DensityField density;
+        GenerateCaveDensity(position, density);
+
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                {
+                    if (density[GetDensityIndex(x, y, z)] < caveThreshold)
+                        blocks.Set(x, y, z, BlockType::BLOCK_AIR);
+                }
+            }
+        }
+    }
+
+    void Decorate(const glm::ivec3& position, const BlockReader& neighborhood, BlockStorage<CHUNK_SIZE>& blocks) const override
+    {
+        for (int x = -1; x <= 1; ++x)
+        {
+            for (int y = -1; y <= 1; ++y)
+            {
+                for (int z = -1; z <= 1; ++z)
+                {
+                    glm::ivec3 origin = position + glm::ivec3(x, y, z) * CHUNK_SIZE;
+
+                    for (int attempt = 0; attempt < treeAttempts; ++attempt)
+                    {
+                        uint32_t hash = Noise::Hash(origin.x, origin.y, origin.z, Noise::GetOctaveSeed(seed ^ 0x7f4a7c15u, attempt));
+
+                        if ((int)(hash % 100) >= treeChance)
+                            continue;
+
+                        glm::ivec3 column = origin + glm::ivec3((hash >> 8) & (CHUNK_SIZE - 1), 0, (hash >> 12) & (CHUNK_SIZE - 1));
+                        int height = 4 + (int)((hash >> 16) % 3);
+
+                        for (int treeY = CHUNK_SIZE - 2; treeY >= 0; --treeY)
+                        {
+                            glm::ivec3 ground = column + glm::ivec3(0, treeY, 0);
+
+                            if (neighborhood.GetBlock(ground) != BlockType::BLOCK_GRASS || IsGround(neighborhood.GetBlock(ground + glm::ivec3(0, 1, 0))))
+                                continue;
+
+                            PlaceTree(position, ground + glm::ivec3(0, 1, 0), height, blocks);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    float SampleCaveDensity(const glm::ivec3& worldPosition) const
+    {
+        float first = Noise::SampleFractal((float)worldPosition.x, (float)worldPosition.y, (float)worldPosition.z, seed ^ 0x5bd1e995u, caveSettings);
+        float second = Noise::SampleFractal((float)worldPosition.x, (float)worldPosition.y, (float)worldPosition.z, seed ^ 0x68e31da4u, caveSettings);
+
+        return std::max(std::abs(first), std::abs(second));
+    }
+
+    void GenerateCaveDensity(const glm::ivec3& position, DensityField& density) const
+    {
+        constexpr int LatticeSize = CHUNK_SIZE / CaveLatticeStep + 1;
+
+        float lattice[LatticeSize][LatticeSize][LatticeSize];
+
+        for (int x = 0; x < LatticeSize; ++x)
+        {
+            for (int y = 0; y < LatticeSize; ++y)
+            {
+                for (int z = 0; z < LatticeSize; ++z)
+                    lattice[x][y][z] = SampleCaveDensity(position + glm::ivec3(x, y, z) * CaveLatticeStep);
+            }
+        }
+
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            int cellX = x / CaveLatticeStep;
+            float fx = (float)(x % CaveLatticeStep) / CaveLatticeStep;
+
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                int cellZ = z / CaveLatticeStep;
+                float fz = (float)(z % CaveLatticeStep) / CaveLatticeStep;
+
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                {
+                    int cellY = y / CaveLatticeStep;
+                    float fy = (float)(y % CaveLatticeStep) / CaveLatticeStep;
+
+                    float bottom = Noise::Lerp(Noise::Lerp(lattice[cellX][cellY][cellZ], lattice[cellX + 1][cellY][cellZ], fx), Noise::Lerp(lattice[cellX][cellY][cellZ + 1], lattice[cellX + 1][cellY][cellZ + 1], fx), fz);
+                    float top = Noise::Lerp(Noise::Lerp(lattice[cellX][cellY + 1][cellZ], lattice[cellX + 1][cellY + 1][cellZ], fx), Noise::Lerp(lattice[cellX][cellY + 1][cellZ + 1], lattice[cellX + 1][cellY + 1][cellZ + 1], fx), fz);
+
+                    density[GetDensityIndex(x, y, z)] = Noise::Lerp(bottom, top, fy);
+                }
+            }
+        }
+    }
+
+    void GenerateCaveDensityFull(const glm::ivec3& position, DensityField& density) const
+    {
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                    density[GetDensityIndex(x, y, z)] = SampleCaveDensity(position + glm::ivec3(x, y, z));
+            }
+        }
+    }
+
+    void LogBenchmark() const override
+    {
+        const int gridCount = 4096;
+
+        Noise::Grid grid;
+        float checksum = 0.0f;
+
+        auto measure = [&](auto sampler)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < gridCount; ++i)
+            {
+                sampler(glm::ivec2{ (i % 64) * CHUNK_SIZE, (i / 64) * CHUNK_SIZE }, seed, settings, grid);
+                checksum += grid[i % grid.size()];
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            return gridCount * grid.size() / std::max(seconds, 1e-9);
+        };
+
+        double scalar = measure(Noise::SampleGridScalar);
+        double vectorized = measure(Noise::SampleGrid);
+
+        Logger_WriteConsole(std::format("Terrain noise ({} octaves): Scalar {:.0f} columns/s; {} {:.0f} columns/s ({:.2f}x, checksum {})", settings.octaves, scalar, Noise::SimdName, vectorized, vectorized / scalar, checksum), LogLevel::INFO);
+
+        const int chunkCount = 64;
+
+        DensityField coarse, full;
+        double coarseSeconds = 0.0, fullSeconds = 0.0, error = 0.0;
+
+        for (int i = 0; i < chunkCount; ++i)
+        {
+            glm::ivec3 position = glm::ivec3(i % 4, i / 16, i / 4 % 4) * CHUNK_SIZE;
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            GenerateCaveDensity(position, coarse);
+
+            std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+            GenerateCaveDensityFull(position, full);
+
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+            coarseSeconds += std::chrono::duration<double>(middle - start).count();
+            fullSeconds += std::chrono::duration<double>(end - middle).count();
+
+            for (size_t sample = 0; sample < coarse.size(); ++sample)
+                error += std::abs(coarse[sample] - full[sample]);
+        }
+
+        Logger_WriteConsole(std::format("Cave density: {}^3 lattice {:.0f} chunks/s; full resolution {:.0f} chunks/s ({:.2f}x, mean error {:.4f})", CaveLatticeStep, chunkCount / std::max(coarseSeconds, 1e-9), chunkCount / std::max(fullSeconds, 1e-9), fullSeconds / std::max(coarseSeconds, 1e-9), error / (chunkCount * coarse.size())), LogLevel::INFO);
+    }
+
+private:
+
+    static int GetDensityIndex(int x, int y, int z)
+    {
+        return (x * CHUNK_SIZE + z) * CHUNK_SIZE + y;
+    }
+
+    static bool IsGround(BlockType type)
+    {
+        return type != BlockType::BLOCK_AIR && type != BlockType::BLOCK_LOG && type != BlockType::BLOCK_LEAVES;
+    }
+
+    static void PlaceBlock(const glm::ivec3& position, const glm::ivec3& worldPosition, BlockType type, BlockStorage<CHUNK_SIZE>& blocks)
+    {
+        glm::ivec3 local = worldPosition - position;
+
+        if (glm::any(glm::lessThan(local, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(local, glm::ivec3(CHUNK_SIZE))))
+            return;
+
+        BlockType existing = blocks.Get(local.x, local.y, local.z);
+
+        if (existing == BlockType::BLOCK_AIR || (type == BlockType::BLOCK_LOG && existing == BlockType::BLOCK_LEAVES))
+            blocks.Set(local.x, local.y, local.z, type);
+    }
+
+    static void PlaceTree(const glm::ivec3& position, const glm::ivec3& base, int height, BlockStorage<CHUNK_SIZE>& blocks)
+    {
+        for (int y = height - 3; y <= height; ++y)
+        {
+            int radius = y >= height - 1 ? 1 : 2;
+
+            for (int x = -radius; x <= radius; ++x)
+            {
+                for (int z = -radius; z <= radius; ++z)
+                {
+                    if (radius == 2 && std::abs(x) == 2 && std::abs(z) == 2)
+                        continue;
+
+                    PlaceBlock(position, base + glm::ivec3(x, y, z), BlockType::BLOCK_LEAVES, blocks);
+                }
+            }
+        }
+
+        for (int y = 0; y < height; ++y)
+            PlaceBlock(position, base + glm::ivec3(0, y, 0), BlockType::BLOCK_LOG, blocks);
+    }
+};
+
+#endif // !TERRAIN_GENERATOR_HPP
\ No newline at end of file
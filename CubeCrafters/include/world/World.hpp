@@ -6,20 +6,129 @@
 #include <chrono>
 #include <functional>
 #include <iostream>
-#include <unordered_set>
 #include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include "core/Settings.hpp"
+#include "math/Frustum.hpp"
 #include "thread/ThreadedChunkMap.hpp"
-#include "thread/ThreadTaskExecutor.hpp"
+#include "thread/JobSystem.hpp"
 #include "world/Chunk.hpp"
+#include "world/LightEngine.hpp"
 
 #define VIEW_DISTANCE 1
+#define VERTICAL_VIEW_DISTANCE 1
+#define GENERATION_PADDING 3
+#define MAX_PENDING_CHUNKS 16
 
 namespace World
 {
     ThreadedChunkMap loadedChunks;
 
+    std::shared_ptr<TerrainGenerator> generator = std::make_shared<NoiseTerrainGenerator>(1337u);
+
     glm::vec3 playerPosition;
-    ThreadTaskExecutor worldExecutor;
+    glm::vec3 playerVelocity;
+    Frustum playerFrustum;
+    std::mutex playerMutex;
+    std::chrono::steady_clock::time_point lastPlayerUpdate;
+
+    SerialJobQueue streamingQueue(JobPriority::HIGH);
+    std::unordered_set<glm::ivec3> readyChunks;
+    glm::ivec3 streamingCenter;
+    glm::ivec3 playerChunkCoordinates;
+    std::atomic<bool> streaming = false;
+    std::atomic<int> runningStages = 0;
+
+    SerialJobQueue lightQueue(JobPriority::HIGH);
+    std::unordered_map<glm::ivec3, BlockType> pendingEdits;
+    std::unordered_map<glm::ivec3, BlockType> deferredEdits;
+    std::atomic<bool> hasDeferredEdits = false;
+    std::mutex editMutex;
+
+    const std::array<glm::ivec3, 26> NEIGHBOR_OFFSETS = []
+    {
+        std::array<glm::ivec3, 26> offsets = {};
+        int count = 0;
+
+        for (int x = -1; x <= 1; ++x)
+        {
+            for (int y = -1; y <= 1; ++y)
+            {
+                for (int z = -1; z <= 1; ++z)
+                {
+                    if (x != 0 || y != 0 || z != 0)
+                        offsets[count++] = { x, y, z };
+                }
+            }
+        }
+
+        return offsets;
+    }();
+
+    class ChunkNeighborhood : public BlockReader
+    {
+
+    public:
+
+        ChunkNeighborhood(const glm::ivec3& chunkCoordinates, ThreadedChunkMap& chunkMap) : center(chunkCoordinates)
+        {
+            for (int x = -1; x <= 1; ++x)
+            {
+                for (int y = -1; y <= 1; ++y)
+                {
+                    for (int z = -1; z <= 1; ++z)
+                        chunks[GetIndex({ x, y, z })] = chunkMap.GetChunk(chunkCoordinates + glm::ivec3(x, y, z));
+                }
+            }
+        }
+
+        BlockType GetBlock(const glm::ivec3& worldPosition) const override
+        {
+            glm::ivec3 offset = glm::ivec3(glm::floor(glm::vec3(worldPosition) / (float)CHUNK_SIZE)) - center;
+
+            if (glm::any(glm::greaterThan(glm::abs(offset), glm::ivec3(1))))
+                return BlockType::BLOCK_AIR;
+
+            const std::shared_ptr<Chunk>& chunk = chunks[GetIndex(offset)];
+
+            if (chunk == nullptr)
+                return BlockType::BLOCK_AIR;
+
+            return chunk->GetBlock(Chunk::WorldToBlockCoordinates(worldPosition));
+        }
+
+    private:
+
+        glm::ivec3 center;
+        std::array<std::shared_ptr<Chunk>, 27> chunks;
+
+        static int GetIndex(const glm::ivec3& offset)
+        {
+            return ((offset.x + 1) * 3 + offset.y + 1) * 3 + offset.z + 1;
+        }
+    };
+
+    float GetLoadPriority(const glm::ivec3& chunkCoordinates, const glm::vec3& position, const glm::vec3& velocity, const Frustum& frustum)
+    {
+        glm::vec3 min = chunkCoordinates * CHUNK_SIZE;
+        glm::vec3 max = min + glm::vec3(CHUNK_SIZE);
+        glm::vec3 offset = (min + max) * 0.5f - position;
+
+        float distance = glm::length(offset) / CHUNK_SIZE;
+        float speed = glm::length(velocity) / CHUNK_SIZE;
+        float priority = distance;
+
+        bool surrounding = glm::all(glm::lessThanEqual(glm::abs(offset), glm::vec3(CHUNK_SIZE)));
+
+        if (!surrounding && !frustum.IntersectsBox(min, max))
+            priority += VIEW_DISTANCE * (1.0f + speed);
+
+        if (speed > 0 && distance > 0)
+            priority -= std::max(glm::dot(offset / (distance * CHUNK_SIZE), velocity / (speed * CHUNK_SIZE)), 0.0f) * std::min(speed, (float)VIEW_DISTANCE);
+
+        return priority;
+    }
 
     glm::ivec3 WorldToChunkCoordinates(const glm::vec3& worldPosition)
     {
@@ -49,95 +158,489 @@ namespace World
         return nullptr;
     }
 
-    void SetBlock(const glm::vec3& worldPosition, BlockType type)
+    int GetStreamingRing(const glm::ivec3& chunkCoordinates, const glm::ivec3& center)
     {
-        glm::ivec3 chunkCoordinates = WorldToChunkCoordinates(worldPosition);
+        glm::ivec3 distance = glm::abs(chunkCoordinates - center);
 
-        std::shared_ptr<Chunk> chunk = loadedChunks.GetChunk(chunkCoordinates);
+        return std::max({ distance.x - VIEW_DISTANCE, distance.y - VERTICAL_VIEW_DISTANCE, distance.z - VIEW_DISTANCE, 0 });
+    }
+
+    bool IsInStreamingRange(const glm::ivec3& chunkCoordinates, const glm::ivec3& center)
+    {
+        return GetStreamingRing(chunkCoordinates, center) <= GENERATION_PADDING;
+    }
+
+    ChunkStage GetTargetStage(const glm::ivec3& chunkCoordinates, const glm::ivec3& center)
+    {
+        switch (GetStreamingRing(chunkCoordinates, center))
+        {
+        case 0: return ChunkStage::UPLOADED;
+        case 1: return ChunkStage::LIT;
+        case 2: return ChunkStage::DECORATED;
+        case 3: return ChunkStage::CARVED;
+        default: return ChunkStage::NONE;
+        }
+    }
+
+    ChunkStage GetRequiredNeighborStage(ChunkStage stage)
+    {
+        switch (stage)
+        {
+        case ChunkStage::DECORATED: return ChunkStage::CARVED;
+        case ChunkStage::LIT: return ChunkStage::DECORATED;
+        case ChunkStage::MESHED: return ChunkStage::LIT;
+        default: return ChunkStage::NONE;
+        }
+    }
+
+    bool CanAdvance(const glm::ivec3& chunkCoordinates, const Chunk& chunk)
+    {
+        if (chunk.stageRunning || chunk.stage >= GetTargetStage(chunkCoordinates, streamingCenter))
+            return false;
+
+        ChunkStage required = GetRequiredNeighborStage((ChunkStage)((int)chunk.stage.load() + 1));
+
+        if (required == ChunkStage::NONE)
+            return true;
+
+        for (const glm::ivec3& offset : NEIGHBOR_OFFSETS)
+        {
+            std::shared_ptr<Chunk> neighbor = loadedChunks.GetChunk(chunkCoordinates + offset);
+
+            if (neighbor == nullptr || neighbor->stage < required)
+                return false;
+        }
+
+        return true;
+    }
+
+    void RebuildChunks(const std::unordered_set<glm::ivec3>& chunkCoordinates)
+    {
+        for (const glm::ivec3& chunkCoordinate : chunkCoordinates)
+        {
+            std::shared_ptr<Chunk> chunk = loadedChunks.GetChunk(chunkCoordinate);
 
-        if (chunk == nullptr && type != BlockType::BLOCK_AIR)
+            if (chunk == nullptr || chunk->stage < ChunkStage::LIT)
+                continue;
+
+            if (chunk->stage < ChunkStage::MESHED)
+            {
+                chunk->meshDirty = true;
+
+                if (chunk->stage < ChunkStage::MESHED || !chunk->meshDirty.exchange(false))
+                    continue;
+            }
+
+            if (chunk->rebuildQueued.exchange(true))
+                continue;
+
+            JobSystem::Schedule([chunk]
+            {
+                chunk->rebuildQueued = false;
+                Chunk::Rebuild(chunk);
+            }, JobPriority::HIGH);
+        }
+    }
+
+    void RunStage(const glm::ivec3& chunkCoordinates, Chunk& chunk, ChunkStage stage, const TerrainGenerator& terrainGenerator)
+    {
+        switch (stage)
         {
-            chunk = std::make_shared<Chunk>();
-            chunk->Initialize(chunkCoordinates * CHUNK_SIZE, true);
+        case ChunkStage::TERRAIN:
+            chunk.GenerateTerrain(terrainGenerator);
+            break;
+
+        case ChunkStage::CARVED:
+            chunk.Carve(terrainGenerator);
+            break;
+
+        case ChunkStage::DECORATED:
+            chunk.Decorate(terrainGenerator, ChunkNeighborhood(chunkCoordinates, loadedChunks));
+            break;
+
+        case ChunkStage::LIT:
+            RebuildChunks(LightEngine::LightChunk(loadedChunks, chunkCoordinates));
+            break;
+
+        case ChunkStage::MESHED:
+            chunk.Mesh();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void DispatchStages();
+
+    void FinishStage(const glm::ivec3& chunkCoordinates, const std::shared_ptr<Chunk>& chunk, ChunkStage stage)
+    {
+        chunk->stage = stage;
+        chunk->stageRunning = false;
+
+        if (stage == ChunkStage::MESHED && chunk->meshDirty.exchange(false))
+            RebuildChunks({ chunkCoordinates });
+
+        if (!streaming || loadedChunks.GetChunk(chunkCoordinates) != chunk)
+            return;
+
+        readyChunks.insert(chunkCoordinates);
+
+        for (const glm::ivec3& offset : NEIGHBOR_OFFSETS)
+            readyChunks.insert(chunkCoordinates + offset);
+
+        DispatchStages();
+    }
+
+    void StartStage(const glm::ivec3& chunkCoordinates, const std::shared_ptr<Chunk>& chunk)
+    {
+        ChunkStage stage = (ChunkStage)((int)chunk->stage.load() + 1);
+        chunk->stageRunning = true;
+
+        if (stage == ChunkStage::UPLOADED)
+        {
+            MainThreadExecutor::QueueTask([chunkCoordinates, chunk]
+            {
+                chunk->Upload();
+                streamingQueue.AddTask([chunkCoordinates, chunk] { FinishStage(chunkCoordinates, chunk, ChunkStage::UPLOADED); });
+            });
+
+            return;
+        }
+
+        runningStages++;
+
+        auto task = [chunkCoordinates, chunk, stage, generator = generator]
+        {
+            RunStage(chunkCoordinates, *chunk, stage, *generator);
+
+            streamingQueue.AddTask([chunkCoordinates, chunk, stage] { FinishStage(chunkCoordinates, chunk, stage); });
+            runningStages--;
+        };
+
+        if (stage == ChunkStage::LIT)
+            lightQueue.AddTask(task);
+        else
+            JobSystem::Schedule(task, stage == ChunkStage::MESHED ? JobPriority::HIGH : JobPriority::NORMAL);
+    }
+
+    void RequestChunk(const glm::ivec3& chunkCoordinates)
+    {
+        if (!loadedChunks.Contains(chunkCoordinates))
+        {
+            std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+            chunk->Initialize(chunkCoordinates * CHUNK_SIZE, loadedChunks);
 
             loadedChunks.AddChunk(chunkCoordinates, chunk);
         }
 
-        if (chunk != nullptr)
+        readyChunks.insert(chunkCoordinates);
+    }
+
+    void UnloadChunk(const glm::ivec3& chunkCoordinates)
+    {
+        readyChunks.erase(chunkCoordinates);
+
+        std::shared_ptr<Chunk> chunk = loadedChunks.GetChunk(chunkCoordinates);
+
+        if (chunk == nullptr)
+            return;
+
+        MainThreadExecutor::QueueTask([chunk] { chunk->CleanUp(); });
+
+        loadedChunks.RemoveChunk(chunkCoordinates);
+    }
+
+    void ApplyEdits(std::unordered_map<glm::ivec3, BlockType> edits)
+    {
+        std::unordered_set<glm::ivec3> rebuilds;
+
+        for (const auto& [worldPosition, type] : deferredEdits)
+            edits.try_emplace(worldPosition, type);
+
+        deferredEdits.clear();
+
+        glm::ivec3 center;
+
+        {
+            std::lock_guard<std::mutex> lock(playerMutex);
+            center = playerChunkCoordinates;
+        }
+
+        size_t dropped = 0;
+
+        for (const auto& [worldPosition, type] : edits)
         {
+            glm::ivec3 chunkCoordinates = WorldToChunkCoordinates(worldPosition);
+
+            std::shared_ptr<Chunk> chunk = loadedChunks.GetChunk(chunkCoordinates);
+
+            if (chunk == nullptr || chunk->stage < ChunkStage::LIT)
+            {
+                if (GetTargetStage(chunkCoordinates, center) >= ChunkStage::LIT)
+                    deferredEdits.insert({ worldPosition, type });
+                else
+                    dropped++;
+
+                continue;
+            }
+
             glm::ivec3 blockPosition = Chunk::WorldToBlockCoordinates(worldPosition);
+            BlockType previous = chunk->GetBlock(blockPosition);
+
+            if (!chunk->SetBlock(blockPosition, type))
+                continue;
 
-            chunk->SetBlock(blockPosition, type);
+            rebuilds.merge(LightEngine::UpdateBlock(loadedChunks, worldPosition, previous, type));
+            rebuilds.insert(chunkCoordinates);
+
+            for (int face = 0; face < 6; ++face)
+            {
+                int axis = FACE_AXES[face];
+                int edge = FACE_NORMALS[face][axis] > 0 ? CHUNK_SIZE - 1 : 0;
+
+                if (blockPosition[axis] == edge)
+                    rebuilds.insert(chunkCoordinates + FACE_NORMALS[face]);
+            }
         }
+
+        hasDeferredEdits = !deferredEdits.empty();
+
+        if (dropped > 0)
+            Logger_WriteConsole(std::format("Dropped {} block edits outside the lit streaming region", dropped), LogLevel::WARNING);
+
+        RebuildChunks(rebuilds);
+    }
+
+    void SetBlock(const glm::vec3& worldPosition, BlockType type)
+    {
+        std::lock_guard<std::mutex> lock(editMutex);
+        pendingEdits[glm::ivec3(glm::floor(worldPosition))] = type;
     }
 
-    void Update()
+    void FlushEdits()
     {
-        glm::ivec3 playerChunkCoordinates = WorldToChunkCoordinates(playerPosition);
+        std::unordered_map<glm::ivec3, BlockType> edits;
+
+        {
+            std::lock_guard<std::mutex> lock(editMutex);
+            edits.swap(pendingEdits);
+        }
+
+        if (!edits.empty() || hasDeferredEdits.exchange(false))
+            lightQueue.AddTask([edits = std::move(edits)]() mutable { ApplyEdits(std::move(edits)); });
+    }
+
+    void LogMeshStatistics()
+    {
+        size_t naiveVertices = 0, naiveIndices = 0;
+        size_t greedyVertices = 0, greedyIndices = 0;
+        size_t chunkCount = 0, blockMemory = 0;
+
+        for (const auto& [coordinate, chunk] : loadedChunks.Copy())
+        {
+            if (chunk->stage < ChunkStage::MESHED)
+                continue;
+
+            chunkCount++;
+            blockMemory += chunk->GetBlockMemoryUsage();
+
+            auto [vertices, indices] = chunk->CountMesh(MeshingMode::NAIVE);
+            naiveVertices += vertices;
+            naiveIndices += indices;
+
+            std::tie(vertices, indices) = chunk->CountMesh(MeshingMode::GREEDY);
+            greedyVertices += vertices;
+            greedyIndices += indices;
+        }
+
+        Logger_WriteConsole(std::format("Naive meshing: {} vertices, {} indices; Greedy meshing: {} vertices, {} indices", naiveVertices, naiveIndices, greedyVertices, greedyIndices), LogLevel::INFO);
+
+        if (chunkCount > 0)
+            Logger_WriteConsole(std::format("Block storage: {} chunks, {:.1f} KB ({} bytes per chunk, {} bytes dense)", chunkCount, blockMemory / 1024.0, blockMemory / chunkCount, CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE * sizeof(BlockType)), LogLevel::INFO);
+    }
+
+    void SetMeshingMode(MeshingMode mode)
+    {
+        Chunk::meshingMode = mode;
+
+        std::vector<std::shared_ptr<Chunk>> chunks;
+
+        for (const auto& [coordinate, chunk] : loadedChunks.Copy())
+        {
+            if (chunk->stage >= ChunkStage::MESHED)
+                chunks.push_back(chunk);
+        }
+
+        std::shared_ptr<std::atomic<size_t>> remaining = std::make_shared<std::atomic<size_t>>(chunks.size());
 
-        for (int x = -VIEW_DISTANCE; x <= VIEW_DISTANCE; x++)
+        for (const std::shared_ptr<Chunk>& chunk : chunks)
         {
-            for (int z = -VIEW_DISTANCE; z <= VIEW_DISTANCE; z++)
+            JobSystem::Schedule([chunk, remaining]
             {
-                glm::ivec3 chunkCoordinate = glm::ivec3(playerChunkCoordinates.x + x, 0, playerChunkCoordinates.z + z);
+                Chunk::Rebuild(chunk);
 
-                if (!loadedChunks.Contains(chunkCoordinate))
-                {
-                    std::shared_ptr<Chunk> chunk(new Chunk());
+                if (--*remaining == 0)
+                    JobSystem::Schedule(LogMeshStatistics, JobPriority::LOW);
+            }, JobPriority::HIGH);
+        }
+    }
+
+    void DispatchStages()
+    {
+        if (!streaming || readyChunks.empty())
+            return;
 
-                    glm::ivec3 worldPosition = { chunkCoordinate.x * CHUNK_SIZE, 0, chunkCoordinate.z * CHUNK_SIZE };
+        glm::vec3 position, velocity;
+        Frustum frustum;
 
-                    if (chunk != nullptr)
-                    {
-                        chunk->Initialize(worldPosition);
+        {
+            std::lock_guard<std::mutex> lock(playerMutex);
 
-                        loadedChunks.AddChunk(chunkCoordinate, chunk);
-                    }
-                }
-            }
+            position = playerPosition;
+            velocity = playerVelocity;
+            frustum = playerFrustum;
         }
 
-        std::unordered_set<glm::ivec3> chunkSet;
+        std::vector<std::tuple<float, glm::ivec3, std::shared_ptr<Chunk>>> orderedChunks;
 
-        loadedChunks.ForEach([&chunkSet](const auto& pair) 
+        for (const glm::ivec3& chunkCoordinate : readyChunks)
         {
-            //if (chunkSet.find(pair.first) != chunkSet.end()) 
-                chunkSet.insert(pair.first);
-        });
-            
-        for (const auto& chunkCoordinate : chunkSet)
+            std::shared_ptr<Chunk> chunk = loadedChunks.GetChunk(chunkCoordinate);
+
+            if (chunk != nullptr && CanAdvance(chunkCoordinate, *chunk))
+                orderedChunks.push_back({ GetLoadPriority(chunkCoordinate, position, velocity, frustum), chunkCoordinate, chunk });
+        }
+
+        std::sort(orderedChunks.begin(), orderedChunks.end(), [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+
+        readyChunks.clear();
+
+        for (const auto& [priority, chunkCoordinate, chunk] : orderedChunks)
         {
-            if ((std::abs(chunkCoordinate.x - playerChunkCoordinates.x) > VIEW_DISTANCE) && (std::abs(chunkCoordinate.z - playerChunkCoordinates.z) > VIEW_DISTANCE))
+            if (runningStages >= MAX_PENDING_CHUNKS && chunk->stage != ChunkStage::MESHED)
+                readyChunks.insert(chunkCoordinate);
+            else
+                StartStage(chunkCoordinate, chunk);
+        }
+    }
+
+    template<typename Func>
+    void ForEachEnteringChunk(const glm::ivec3& from, const glm::ivec3& to, int padding, Func func)
+    {
+        int horizontal = VIEW_DISTANCE + padding;
+        int vertical = VERTICAL_VIEW_DISTANCE + padding;
+
+        for (int x = to.x - horizontal; x <= to.x + horizontal; x++)
+        {
+            for (int y = to.y - vertical; y <= to.y + vertical; y++)
             {
-                loadedChunks.GetChunk(chunkCoordinate)->CleanUp();
+                if (std::abs(x - from.x) > horizontal || std::abs(y - from.y) > vertical)
+                {
+                    for (int z = to.z - horizontal; z <= to.z + horizontal; z++)
+                        func(glm::ivec3(x, y, z));
+
+                    continue;
+                }
+
+                for (int z = to.z - horizontal; z <= std::min(to.z + horizontal, from.z - horizontal - 1); z++)
+                    func(glm::ivec3(x, y, z));
 
-                loadedChunks.RemoveChunk(chunkCoordinate);
+                for (int z = std::max(to.z - horizontal, from.z + horizontal + 1); z <= to.z + horizontal; z++)
+                    func(glm::ivec3(x, y, z));
             }
         }
     }
 
+    void MoveStreamingCenter(const glm::ivec3& center)
+    {
+        glm::ivec3 previousCenter = streamingCenter;
+        streamingCenter = center;
+
+        ForEachEnteringChunk(center, previousCenter, GENERATION_PADDING, [](const glm::ivec3& chunkCoordinate) { UnloadChunk(chunkCoordinate); });
+
+        for (int padding = 0; padding <= GENERATION_PADDING; ++padding)
+            ForEachEnteringChunk(previousCenter, center, padding, [](const glm::ivec3& chunkCoordinate) { RequestChunk(chunkCoordinate); });
+
+        DispatchStages();
+    }
+
+    void UpdatePlayer(const glm::vec3& position, const glm::mat4& viewProjection)
+    {
+        std::lock_guard<std::mutex> lock(playerMutex);
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        float deltaTime = std::chrono::duration<float>(now - lastPlayerUpdate).count();
+
+        if (deltaTime > 0 && deltaTime < 1.0f)
+            playerVelocity = glm::mix(playerVelocity, (position - playerPosition) / deltaTime, 0.25f);
+        else
+            playerVelocity = {};
+
+        playerPosition = position;
+        playerFrustum = Frustum::Register(viewProjection);
+        lastPlayerUpdate = now;
+
+        glm::ivec3 chunkCoordinates = WorldToChunkCoordinates(position);
+
+        if (chunkCoordinates == playerChunkCoordinates)
+            return;
+
+        playerChunkCoordinates = chunkCoordinates;
+
+        if (streaming)
+            streamingQueue.AddTask([chunkCoordinates] { MoveStreamingCenter(chunkCoordinates); });
+    }
+
+    void SetGenerator(std::shared_ptr<TerrainGenerator> terrainGenerator)
+    {
+        streamingQueue.AddTask([terrainGenerator]
+        {
+            generator = terrainGenerator;
+            LightEngine::skyHeight = generator->GetMaxHeight();
+        });
+    }
+
     void StartUpdating()
     {
-        worldExecutor.AddTask([&]
+        streaming = true;
+
+        if (Settings::runBenchmarks)
+            JobSystem::Schedule([generator = generator] { generator->LogBenchmark(); }, JobPriority::LOW);
+
+        streamingQueue.AddTask([]
         {
-            try
+            LightEngine::skyHeight = generator->GetMaxHeight();
+
             {
-                while (true)
-                {
-                    Update();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
+                std::lock_guard<std::mutex> lock(playerMutex);
+                streamingCenter = playerChunkCoordinates;
             }
-            catch (...)
+
+            for (int x = -VIEW_DISTANCE - GENERATION_PADDING; x <= VIEW_DISTANCE + GENERATION_PADDING; x++)
             {
-                Logger_ThrowError("...", "Thread error! Thread 'world' crashed unexpectedly!", true);
+                for (int y = -VERTICAL_VIEW_DISTANCE - GENERATION_PADDING; y <= VERTICAL_VIEW_DISTANCE + GENERATION_PADDING; y++)
+                {
+                    for (int z = -VIEW_DISTANCE - GENERATION_PADDING; z <= VIEW_DISTANCE + GENERATION_PADDING; z++)
+                        RequestChunk(streamingCenter + glm::ivec3(x, y, z));
+                }
             }
+
+            DispatchStages();
         });
     }
 
     void StopUpdating()
     {
-        worldExecutor.Terminate();
+        streaming = false;
+
+        streamingQueue.AddTask([] { readyChunks.clear(); });
+
+        while (runningStages > 0)
+        {
+            if (!JobSystem::RunPendingJob())
+                std::this_thread::yield();
+        }
     }
 }
 
@@ -2,6 +2,7 @@
 
 in vec3 color;
 in vec2 texCoords;
+flat in vec4 textureBounds;
 
 out vec4 FragColor;
 
@@ -9,5 +10,16 @@ uniform sampler2D diffuse;
 
 void main()
 {
-    FragColor = texture(diffuse, texCoords) * vec4(color, 1.0);
+    vec4 sampled;
+
+    if (textureBounds.z > textureBounds.x)
+    {
+        vec2 tileSize = textureBounds.zw - textureBounds.xy;
+
+        sampled = textureGrad(diffuse, mix(textureBounds.xy, textureBounds.zw, fract(texCoords)), dFdx(texCoords) * tileSize, dFdy(texCoords) * tileSize);
+    }
+    else
+        sampled = texture(diffuse, texCoords);
+
+    FragColor = sampled * vec4(color, 1.0);
 }
\ No newline at end of file
@@ -2,21 +2,63 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in uint aPackedData;
 
 out vec3 fragPos;
 out vec3 color;
 out vec2 texCoords;
+flat out vec4 textureBounds;
 
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+uniform bool packedVertices;
+uniform float atlasSlots;
+uniform vec2 atlasSlotSize;
+uniform vec2 atlasTileSize;
+uniform vec2 atlasGutter;
+
 void main()
 {
-    fragPos = vec3(model * vec4(aPos, 1.0));
+    vec3 position = aPos;
+
     texCoords = aTexCoords;
+    textureBounds = vec4(0.0);
 
     color = aColor;
 
+    if (packedVertices)
+    {
+        position = vec3(aPackedData & 31u, (aPackedData >> 5) & 31u, (aPackedData >> 10) & 31u);
+
+        uint face = (aPackedData >> 15) & 7u;
+        uint tile = (aPackedData >> 18) & 255u;
+
+        if (face == 0u)
+            texCoords = vec2(-position.z, position.x);
+        else if (face == 1u)
+            texCoords = position.xz;
+        else if (face == 2u)
+            texCoords = position.xy;
+        else if (face == 3u)
+            texCoords = vec2(-position.x, position.y);
+        else if (face == 4u)
+            texCoords = vec2(-position.z, position.y);
+        else
+            texCoords = position.zy;
+
+        vec2 tileOrigin = vec2(float(tile % uint(atlasSlots)), float(tile / uint(atlasSlots))) * atlasSlotSize + atlasGutter;
+
+        textureBounds = vec4(tileOrigin, tileOrigin + atlasTileSize);
+
+        float light = float((aPackedData >> 26) & 15u);
+        float occlusion = float(aPackedData >> 30) / 3.0;
+
+        color = vec3(pow(0.8, 15.0 - light) * mix(0.5, 1.0, occlusion));
+    }
+
+    fragPos = vec3(model * vec4(position, 1.0));
+
     gl_Position = projection * view * vec4(fragPos, 1.0);
 }
\ No newline at end of file